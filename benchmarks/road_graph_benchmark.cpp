@@ -0,0 +1,219 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+// Routing benchmark on a synthetic grid of lanes.
+//
+// usage: road_graph_benchmark [rows] [columns] [queries]   (default 250 x 400 = 100k lanes, 200 queries)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "adore_map/compact_road_graph.hpp"
+#include "adore_map/contraction_hierarchy.hpp"
+#include "adore_map/landmarks.hpp"
+#include "adore_map/lane_store.hpp"
+#include "adore_map/road_graph.hpp"
+#include "adore_map/weight_overlay.hpp"
+
+namespace
+{
+
+// Grid of lanes 10 to 15 m long, each connected to its neighbours in all four directions, with lane changes
+// to the left neighbour on every other row
+adore::map::RoadGraph
+make_grid_graph( size_t rows, size_t columns, unsigned seed )
+{
+  std::mt19937                           rng( seed );
+  std::uniform_real_distribution<double> length( 10.0, 15.0 );
+
+  adore::map::RoadGraph graph;
+  auto                  add = [&]( size_t from, size_t to, adore::map::ConnectionType type ) {
+    adore::map::Connection connection;
+    connection.from_id         = from;
+    connection.to_id           = to;
+    connection.weight          = length( rng );
+    connection.connection_type = type;
+    graph.add_connection( connection );
+  };
+
+  for( size_t row = 0; row < rows; ++row )
+  {
+    for( size_t column = 0; column < columns; ++column )
+    {
+      const size_t lane_id = row * columns + column + 1;
+      if( column + 1 < columns )
+        add( lane_id, lane_id + 1, adore::map::END_TO_START );
+      if( row + 1 < rows )
+        add( lane_id, lane_id + columns, adore::map::END_TO_START );
+      if( row > 0 )
+        add( lane_id, lane_id - columns, adore::map::END_TO_START );
+      if( column > 0 )
+        add( lane_id, lane_id - 1, row % 2 == 0 ? adore::map::PARALLEL : adore::map::END_TO_START );
+    }
+  }
+  return graph;
+}
+
+// Lanes of make_grid_graph, entered at the points of a 10 m grid so no connection is shorter than the
+// distance it bridges
+adore::map::LaneStore
+make_grid_lanes( size_t rows, size_t columns )
+{
+  adore::map::LaneStore lanes;
+  for( size_t row = 0; row < rows; ++row )
+  {
+    for( size_t column = 0; column < columns; ++column )
+    {
+      auto lane = std::make_shared<adore::map::Lane>();
+      lane->id  = row * columns + column + 1;
+      lane->borders.center.interpolated_points.emplace_back( column * 10.0, row * 10.0, lane->id );
+      lane->borders.center.interpolated_points.emplace_back( column * 10.0 + 5.0, row * 10.0, lane->id );
+      lanes.insert( lane );
+    }
+  }
+  return lanes;
+}
+
+double
+seconds_since( std::chrono::steady_clock::time_point start )
+{
+  return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+// Runs a path search for every query and prints the mean time per query
+void
+time_queries( const std::string& name, const std::vector<std::pair<size_t, size_t>>& queries,
+              const std::function<size_t( size_t, size_t )>& search )
+{
+  size_t     total_length = 0;
+  const auto start        = std::chrono::steady_clock::now();
+  for( const auto& [from, to] : queries )
+    total_length += search( from, to );
+  const double elapsed = seconds_since( start );
+
+  std::cout << std::left << std::setw( 32 ) << name << std::right << std::fixed << std::setprecision( 3 ) << std::setw( 10 )
+            << 1e3 * elapsed / queries.size() << " ms/query  (" << total_length << " lanes on all paths)" << std::endl;
+}
+
+} // namespace
+
+int
+main( int argc, char** argv )
+{
+  const size_t rows    = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 250;
+  const size_t columns = argc > 2 ? std::strtoul( argv[2], nullptr, 10 ) : 400;
+  const size_t count   = argc > 3 ? std::strtoul( argv[3], nullptr, 10 ) : 200;
+  if( rows < 2 || columns < 2 || count == 0 )
+  {
+    std::cerr << "usage: " << argv[0] << " [rows >= 2] [columns >= 2] [queries > 0]" << std::endl;
+    return 2;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  auto graph = make_grid_graph( rows, columns, 42 );
+  std::cout << "built grid of " << rows * columns << " lanes and " << graph.all_connections.size() << " connections in "
+            << seconds_since( start ) << " s" << std::endl;
+
+  const auto lanes = make_grid_lanes( rows, columns );
+
+  start        = std::chrono::steady_clock::now();
+  auto compact = adore::map::CompactRoadGraph::build( graph );
+  std::cout << "built compact graph in " << seconds_since( start ) << " s" << std::endl;
+
+  start           = std::chrono::steady_clock::now();
+  auto positioned = adore::map::CompactRoadGraph::build( graph, &lanes );
+  std::cout << "built compact graph with lane positions in " << seconds_since( start ) << " s, heuristic scale "
+            << positioned.get_heuristic_scale() << std::endl;
+
+  start                = std::chrono::steady_clock::now();
+  const auto landmarks = std::make_shared<const adore::map::LandmarkIndex>( adore::map::LandmarkIndex::build( compact ) );
+  std::cout << "built " << landmarks->landmark_count() << " landmarks in " << seconds_since( start ) << " s" << std::endl;
+
+  auto alt = compact;
+  alt.set_landmarks( landmarks );
+  auto alt_positioned = positioned;
+  alt_positioned.set_landmarks( landmarks );
+
+  // A uniform grid has no road hierarchy to exploit, so contraction is slow and only timed on small grids
+  std::optional<adore::map::ContractionHierarchy> hierarchy;
+  if( rows * columns <= 20000 )
+  {
+    start = std::chrono::steady_clock::now();
+    hierarchy.emplace( adore::map::ContractionHierarchy::build( compact ) );
+    std::cout << "built contraction hierarchy in " << seconds_since( start ) << " s, " << hierarchy->shortcut_count()
+              << " shortcuts" << std::endl;
+  }
+
+  // Random pairs of lanes, every lane can reach every other one
+  std::mt19937                           rng( 7 );
+  std::uniform_int_distribution<size_t>  lane( 1, rows * columns );
+  std::vector<std::pair<size_t, size_t>> queries;
+  for( size_t i = 0; i < count; ++i )
+    queries.emplace_back( lane( rng ), lane( rng ) );
+
+  time_queries( "RoadGraph::find_path", queries, [&]( size_t from, size_t to ) { return graph.find_path( from, to, false ).size(); } );
+  time_queries( "CompactRoadGraph Dijkstra", queries, [&]( size_t from, size_t to ) { return compact.find_path( from, to, false ).size(); } );
+  time_queries( "CompactRoadGraph bidirectional", queries,
+                [&]( size_t from, size_t to ) { return compact.find_path_bidirectional( from, to, false ).size(); } );
+  time_queries( "CompactRoadGraph A*", queries, [&]( size_t from, size_t to ) { return positioned.find_path( from, to, false ).size(); } );
+  time_queries( "CompactRoadGraph ALT", queries, [&]( size_t from, size_t to ) { return alt.find_path( from, to, false ).size(); } );
+  time_queries( "CompactRoadGraph ALT + positions", queries,
+                [&]( size_t from, size_t to ) { return alt_positioned.find_path( from, to, false ).size(); } );
+  time_queries( "CompactRoadGraph reachable 200", queries,
+                [&]( size_t from, size_t ) { return compact.find_reachable( from, 200.0 ).lanes.size(); } );
+  if( hierarchy )
+    time_queries( "ContractionHierarchy", queries, [&]( size_t from, size_t to ) { return hierarchy->find_path( from, to ).size(); } );
+
+  time_queries( "CompactRoadGraph 3 alternatives", queries, [&]( size_t from, size_t to ) {
+    size_t length = 0;
+    for( const auto& path : compact.find_alternative_paths( from, to, { 3 } ) )
+      length += path.size();
+    return length;
+  } );
+
+  // Overlay on the ALT graph closing every 101st lane and slowing down every 10th, without touching it
+  start            = std::chrono::steady_clock::now();
+  auto alt_graph   = std::make_shared<const adore::map::CompactRoadGraph>( alt );
+  auto overlay     = adore::map::WeightOverlay( alt_graph );
+  for( size_t lane_id = 1; lane_id <= rows * columns; lane_id += 10 )
+    overlay.scale_lane( lane_id, 2.0 );
+  for( size_t lane_id = 50; lane_id <= rows * columns; lane_id += 101 )
+    overlay.close_lane( lane_id );
+  std::cout << "built weight overlay in " << seconds_since( start ) << " s" << std::endl;
+  time_queries( "ALT with weight overlay", queries, [&]( size_t from, size_t to ) { return overlay.find_path( from, to, false ).size(); } );
+
+  // Closures: every 20th connection five times slower, the landmarks of the original graph stay valid
+  std::vector<adore::map::Connection> connections( graph.all_connections.begin(), graph.all_connections.end() );
+  std::sort( connections.begin(), connections.end(), []( const adore::map::Connection& a, const adore::map::Connection& b ) {
+    return a.from_id < b.from_id || ( a.from_id == b.from_id && a.to_id < b.to_id );
+  } );
+  for( size_t i = 0; i < connections.size(); i += 20 )
+    graph.set_weight( connections[i].from_id, connections[i].to_id, 5.0 * connections[i].weight );
+
+  const auto closed     = adore::map::CompactRoadGraph::build( graph );
+  auto       closed_alt = closed;
+  closed_alt.set_landmarks( landmarks );
+  time_queries( "Dijkstra after closures", queries, [&]( size_t from, size_t to ) { return closed.find_path( from, to, false ).size(); } );
+  time_queries( "ALT after closures", queries, [&]( size_t from, size_t to ) { return closed_alt.find_path( from, to, false ).size(); } );
+  return 0;
+}
@@ -55,7 +55,7 @@ struct Border
   // Get an interpolated point at a given s value
   MapPoint get_interpolated_point( double s ) const;
 
-  double find_nearest_s( const MapPoint& point );
+  double find_nearest_s( const MapPoint& point ) const;
 
   Border make_clipped( double s_start, double s_send ) const;
 
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -78,8 +79,34 @@ private:
 
 public:
 
+  // Per segment polynomial coefficients of one axis, value = a + b ds + c ds^2 + d ds^3
+  struct Coefficients
+  {
+    std::vector<double> a, b, c, d;
+  };
+
   BorderSpline() = default;
 
+  // Restore a spline from previously fitted knots and coefficients without solving the system again
+  BorderSpline( std::vector<double> distances, Coefficients x, Coefficients y ) :
+    distances_( std::move( distances ) ),
+    a_x_( std::move( x.a ) ),
+    b_x_( std::move( x.b ) ),
+    c_x_( std::move( x.c ) ),
+    d_x_( std::move( x.d ) ),
+    a_y_( std::move( y.a ) ),
+    b_y_( std::move( y.b ) ),
+    c_y_( std::move( y.c ) ),
+    d_y_( std::move( y.d ) )
+  {
+    const size_t n = distances_.size();
+    if( n < 2 || a_x_.size() != n - 1 || b_x_.size() != n - 1 || c_x_.size() != n || d_x_.size() != n - 1 || a_y_.size() != n - 1
+        || b_y_.size() != n - 1 || c_y_.size() != n || d_y_.size() != n - 1 )
+    {
+      throw std::invalid_argument( "Inconsistent spline coefficients." );
+    }
+  }
+
   // Initialize spline from points
   BorderSpline( const std::vector<MapPoint>& points )
   {
@@ -241,6 +268,25 @@ public:
     return points;
   }
 
+  // Knots of the spline, cumulative distance at the start of each segment plus the total length
+  const std::vector<double>&
+  get_distances() const
+  {
+    return distances_;
+  }
+
+  Coefficients
+  get_x_coefficients() const
+  {
+    return { a_x_, b_x_, c_x_, d_x_ };
+  }
+
+  Coefficients
+  get_y_coefficients() const
+  {
+    return { a_y_, b_y_, c_y_, d_y_ };
+  }
+
   // Get the total length of the spline
   double
   get_total_length() const
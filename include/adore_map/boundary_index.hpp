@@ -0,0 +1,132 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "adore_map/lane.hpp"
+#include "adore_map/lane_polygons.hpp"
+#include "adore_map/lane_store.hpp"
+#include "adore_map/map_point.hpp"
+#include "adore_map/quadtree.hpp"
+#include "adore_math/point.h"
+
+namespace adore
+{
+namespace map
+{
+
+enum BorderSide
+{
+  inner_border,
+  outer_border
+};
+
+enum BoundaryType
+{
+  lane_divider, // a drivable lane continues on the other side
+  road_edge     // the drivable area ends at the boundary
+};
+
+struct BoundaryConfig
+{
+  double                probe_distance = 0.25; // [m] how far across a boundary to look for a neighbouring lane
+  std::vector<LaneType> drivable_types{ driving, parking, bus };
+};
+
+// Straight piece of a lane border between two interpolated points
+struct BoundarySegment
+{
+  LaneID               lane_id = 0;
+  BorderSide           side    = inner_border;
+  BoundaryType         type    = road_edge;
+  adore::math::Point2d start;
+  adore::math::Point2d end;
+  double               start_s = 0.0; // s of the border at start and end
+  double               end_s   = 0.0;
+};
+
+// Point on a boundary found by a query
+struct BoundaryHit
+{
+  LaneID       lane_id  = 0;
+  BorderSide   side     = inner_border;
+  BoundaryType type     = road_edge;
+  double       x        = 0.0;
+  double       y        = 0.0;
+  double       s        = 0.0; // along the border
+  double       distance = 0.0; // [m] from the query point, or from the start of the query segment
+};
+
+// Bounding volume hierarchy over the inner and outer borders of all lanes.
+//
+// Every border segment knows its lane, its side and whether it divides two drivable lanes or bounds the
+// drivable area, which is decided once at build time by probing the lane outlines just across it. Borders
+// shared by neighbouring lanes are indexed once per lane. The index is immutable once built and can be
+// shared between threads.
+class BoundaryIndex
+{
+public:
+
+  using Boundary = Quadtree<MapPoint>::Boundary;
+
+  BoundaryIndex() {};
+
+  // Builds the index on thread_count threads (0 = all cores). Outlines are built if none are given.
+  static BoundaryIndex build( const LaneStore& lanes, const BoundaryConfig& config = BoundaryConfig(), size_t thread_count = 0,
+                              const LanePolygonIndex* outlines = nullptr );
+
+  // Closest point on any boundary (of one type, if given) within max_distance
+  std::optional<BoundaryHit> nearest( double x, double y, double max_distance = std::numeric_limits<double>::max(),
+                                      std::optional<BoundaryType> type = std::nullopt ) const;
+
+  // All boundaries crossed by the segment from (start_x, start_y) to (end_x, end_y), in order along it
+  std::vector<BoundaryHit> crossings( double start_x, double start_y, double end_x, double end_y ) const;
+
+  const std::vector<BoundarySegment>&
+  get_segments() const
+  {
+    return segments;
+  }
+
+  size_t
+  size() const
+  {
+    return segments.size();
+  }
+
+private:
+
+  // Inner nodes reference two children, leaves a range of segments
+  struct Node
+  {
+    Boundary box{ 0.0, 0.0, 0.0, 0.0 };
+    uint32_t left  = 0; // first child, or first segment of a leaf
+    uint32_t right = 0; // second child, or segment count of a leaf
+    bool     leaf  = false;
+  };
+
+  static constexpr size_t LEAF_SIZE = 8;
+
+  uint32_t build_node( size_t begin, size_t end );
+
+  std::vector<BoundarySegment> segments; // ordered so each leaf covers a contiguous range
+  std::vector<Node>            nodes;    // nodes[0] is the root
+};
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,230 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "adore_map/landmarks.hpp"
+#include "adore_map/lane.hpp"
+#include "adore_map/lane_store.hpp"
+#include "adore_map/road_graph.hpp"
+#include "adore_math/point.h"
+
+namespace adore
+{
+namespace map
+{
+
+using NodeIndex = uint32_t;
+
+constexpr NodeIndex NO_NODE = std::numeric_limits<NodeIndex>::max();
+
+class WeightOverlay;
+
+// Connection stored inline in the edge arrays
+struct CompactEdge
+{
+  NodeIndex      target = NO_NODE; // to lane for forward edges, from lane for reverse edges
+  ConnectionType type   = END_TO_START;
+  double         weight = 0.0;
+};
+
+// Entry points of lanes by id, taken from the lanes a compact graph was built with. RoadGraph keeps them so
+// graphs rebuilt after an edit still search with A* without holding on to the lanes.
+struct LanePositions
+{
+  std::vector<LaneID>               lane_ids;  // sorted
+  std::vector<adore::math::Point2d> positions; // by index in lane_ids
+
+  // Entry point of a lane, nullptr if unknown
+  const adore::math::Point2d*
+  find( LaneID lane_id ) const
+  {
+    auto it = std::lower_bound( lane_ids.begin(), lane_ids.end(), lane_id );
+    if( it == lane_ids.end() || *it != lane_id )
+      return nullptr;
+    return &positions[it - lane_ids.begin()];
+  }
+};
+
+// Frozen lane graph in compressed sparse row form.
+//
+// Lanes are numbered densely in ascending id order. The outgoing connections of node v are
+// forward_edges[forward_offsets[v] .. forward_offsets[v + 1]) and its incoming connections the same range
+// of the reverse arrays, each with its weight and connection type, so a search reads contiguous memory
+// instead of hashing per neighbour. The graph is immutable once built and can be shared between threads.
+//
+// Given the lanes, every node also stores the point where its lane is entered in driving direction. Path
+// searches then run A* with the straight line distance between those points, scaled down to the smallest
+// ratio of connection weight to the distance it bridges so the estimate never exceeds the remaining cost
+// (admissible and consistent) whatever the weights mean. Landmark distances (ALT) tighten the estimate
+// further, see LandmarkIndex.
+class CompactRoadGraph
+{
+public:
+
+  CompactRoadGraph() {};
+
+  // Lanes are optional; without them (or if a connected lane is missing) searches fall back to Dijkstra
+  static CompactRoadGraph build( const RoadGraph& graph, const LaneStore* lanes = nullptr );
+
+  // Same as build, with lane entry points recorded from an earlier build instead of the lanes
+  static CompactRoadGraph build( const RoadGraph& graph, const LanePositions& lane_positions );
+
+  // Entry points of all nodes, empty if the graph was built without (complete) lane positions
+  LanePositions get_lane_positions() const;
+
+  // Node of a lane, NO_NODE if the lane has no connections
+  NodeIndex
+  find_node( LaneID lane_id ) const
+  {
+    auto it = std::lower_bound( lane_ids.begin(), lane_ids.end(), lane_id );
+    if( it == lane_ids.end() || *it != lane_id )
+      return NO_NODE;
+    return static_cast<NodeIndex>( it - lane_ids.begin() );
+  }
+
+  LaneID
+  get_lane_id( NodeIndex node ) const
+  {
+    return lane_ids[node];
+  }
+
+  std::span<const CompactEdge>
+  get_successors( NodeIndex node ) const
+  {
+    return { forward_edges.data() + forward_offsets[node], forward_edges.data() + forward_offsets[node + 1] };
+  }
+
+  std::span<const CompactEdge>
+  get_predecessors( NodeIndex node ) const
+  {
+    return { reverse_edges.data() + reverse_offsets[node], reverse_edges.data() + reverse_offsets[node + 1] };
+  }
+
+  size_t
+  node_count() const
+  {
+    return lane_ids.size();
+  }
+
+  size_t
+  edge_count() const
+  {
+    return forward_edges.size();
+  }
+
+  // Factor from straight line distance to a lower bound of the path cost, 0 without lane positions
+  double
+  get_heuristic_scale() const
+  {
+    return heuristic_scale;
+  }
+
+  // Lower bound of the cost from one node to another
+  double
+  estimate_cost( NodeIndex from, NodeIndex to, bool allow_reverse = false ) const
+  {
+    double estimate = 0.0;
+    if( heuristic_scale > 0.0 )
+      estimate = heuristic_scale * std::hypot( positions[from].x - positions[to].x, positions[from].y - positions[to].y );
+    if( landmarks )
+      estimate = std::max( estimate, landmarks->lower_bound( landmark_rows[from], landmark_rows[to], allow_reverse ) );
+    return estimate;
+  }
+
+  // Uses the landmark distances in the estimates of find_path. The index may come from an earlier version
+  // of the graph as long as connections only got more expensive or were removed since.
+  void set_landmarks( std::shared_ptr<const LandmarkIndex> landmark_index );
+
+  const std::shared_ptr<const LandmarkIndex>&
+  get_landmarks() const
+  {
+    return landmarks;
+  }
+
+  // A* (Dijkstra without lane positions or landmarks), same semantics as RoadGraph::find_path. With an
+  // overlay made for this graph its weights replace the connection weights, closed connections are skipped.
+  // Throws std::runtime_error if the overlay belongs to a different graph. The other searches take an
+  // overlay the same way.
+  std::deque<LaneID> find_path( LaneID from, LaneID to, bool allow_reverse, const std::function<bool( LaneID )>& lane_filter = nullptr,
+                                const WeightOverlay* overlay = nullptr ) const;
+
+  // Dijkstra from both ends at once, forward from the start and backward over the predecessors from the
+  // goal, until the frontiers meet. Same semantics and path costs as find_path.
+  std::deque<LaneID> find_path_bidirectional( LaneID from, LaneID to, bool allow_reverse,
+                                              const std::function<bool( LaneID )>& lane_filter = nullptr,
+                                              const WeightOverlay*                 overlay     = nullptr ) const;
+
+  // Bounded one-to-many Dijkstra, same semantics as RoadGraph::find_reachable
+  ReachableSet find_reachable( LaneID from, double max_cost, SearchDirection direction = FORWARD, bool allow_lane_changes = true,
+                               std::span<const LaneID> targets = {}, const WeightOverlay* overlay = nullptr ) const;
+
+  // Costs between a node and all nodes over successors, predecessors or both, infinite where unreachable.
+  // From the node unless to_source, which only matters for the overlay weights.
+  std::vector<double> shortest_costs( NodeIndex source, bool successors, bool predecessors, const WeightOverlay* overlay = nullptr,
+                                      bool to_source = false ) const;
+
+  // Yen's k shortest loopless paths, same semantics as RoadGraph::find_alternative_paths
+  std::vector<std::deque<LaneID>> find_alternative_paths( LaneID from, LaneID to, const AlternativeRouteConfig& config = {},
+                                                          const WeightOverlay* overlay = nullptr ) const;
+
+  // Version of the RoadGraph the graph was built from, see RoadGraph::version
+  uint64_t
+  get_version() const
+  {
+    return version;
+  }
+
+private:
+
+  friend class WeightOverlay;
+
+  // A* from source to target within max_cost on the costs to the target in the full graph, avoiding the
+  // nodes stamped in blocked and the steps from source to the excluded nodes. Fills the nodes of the path
+  // with their costs from source, false if there is none.
+  bool find_spur_path( NodeIndex source, NodeIndex target, bool allow_reverse, const std::vector<double>& to_target,
+                       const std::vector<uint32_t>& blocked, uint32_t stamp, std::span<const NodeIndex> excluded, double max_cost,
+                       std::vector<NodeIndex>& nodes, std::vector<double>& costs, const WeightOverlay* overlay ) const;
+
+  // Entry points of the lanes and the heuristic scale, leaves positions empty if a lane is missing
+  void set_positions( const LaneStore& lanes );
+  void set_positions( const LanePositions& lane_positions );
+  void set_heuristic_scale();
+
+  uint64_t                 version = 0;
+  std::vector<LaneID>      lane_ids; // by node, sorted
+  std::vector<uint32_t>    forward_offsets;
+  std::vector<CompactEdge> forward_edges;
+  std::vector<uint32_t>    reverse_offsets;
+  std::vector<CompactEdge> reverse_edges;
+
+  std::vector<adore::math::Point2d> positions; // by node, where the lane is entered in driving direction
+  double                            heuristic_scale = 0.0;
+
+  std::shared_ptr<const LandmarkIndex> landmarks;
+  std::vector<uint32_t>                landmark_rows; // by node, row in the landmark tables
+};
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,353 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "adore_map/map.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Flat on-disk layout of a compiled map.
+//
+// A compiled map is a header followed by a number of sections, each an array of fixed size records.
+// All references between records are indices into other sections and all section offsets are relative
+// to the start of the file, so the whole file can be memory mapped (or placed in shared memory) at any
+// address and read in place. Records are plain data with 8 byte alignment, stored in host byte order.
+namespace compiled
+{
+
+constexpr char     MAGIC[8]       = { 'A', 'D', 'O', 'R', 'E', 'M', 'A', 'P' };
+constexpr uint32_t FORMAT_VERSION = 2;
+constexpr uint32_t ENDIAN_MARKER  = 0x01020304;
+constexpr uint64_t NONE           = std::numeric_limits<uint64_t>::max();
+
+enum Section : uint32_t
+{
+  POINTS,        // PointRecord, all border points of all lanes
+  SPLINES,       // SplineRecord
+  SPLINE_VALUES, // double, knots and coefficients referenced by SplineRecord
+  LANES,         // LaneRecord, sorted by id
+  ROADS,         // RoadRecord
+  ROAD_LANE_IDS, // uint64_t, lane ids referenced by RoadRecord
+  NAMES,         // char, road names referenced by RoadRecord
+  CONNECTIONS,   // ConnectionRecord, the lane graph sorted by from_id, to_id
+  PREDECESSORS,  // uint64_t, indices into CONNECTIONS sorted by to_id, from_id
+  INDEX_NODES,   // IndexNodeRecord, the quadtree in preorder
+  INDEX_POINTS,  // PointRecord, points referenced by IndexNodeRecord
+  SECTION_COUNT
+};
+
+struct SectionEntry
+{
+  uint64_t offset = 0; // in bytes from the start of the file
+  uint64_t count  = 0; // number of records
+};
+
+struct Header
+{
+  char         magic[8];
+  uint32_t     version;
+  uint32_t     endian_marker;
+  uint64_t     file_size;
+  uint64_t     index_capacity;
+  SectionEntry sections[SECTION_COUNT];
+};
+
+struct PointRecord
+{
+  double   x;
+  double   y;
+  double   s;
+  double   max_speed;
+  uint64_t parent_id;
+  uint64_t has_max_speed;
+};
+
+struct Range
+{
+  uint64_t first;
+  uint64_t count;
+};
+
+// Spline with n segments, stored in SPLINE_VALUES as distances (n + 1), a_x, b_x (n), c_x (n + 1), d_x (n), then the same for y
+struct SplineRecord
+{
+  uint64_t first_value;
+  uint64_t segment_count;
+};
+
+struct BorderRecord
+{
+  Range    points;              // into POINTS
+  Range    interpolated_points; // into POINTS
+  double   length;
+  uint64_t spline; // into SPLINES, NONE if the border has no spline
+};
+
+struct LaneRecord
+{
+  uint64_t     id;
+  uint64_t     road_id;
+  double       length;
+  double       speed_limit;
+  uint32_t     type;
+  uint32_t     material;
+  uint32_t     left_of_reference;
+  uint32_t     reserved;
+  BorderRecord inner;
+  BorderRecord outer;
+  BorderRecord center;
+};
+
+struct RoadRecord
+{
+  uint64_t id;
+  uint32_t category;
+  uint32_t one_way;
+  Range    name;     // into NAMES
+  Range    lane_ids; // into ROAD_LANE_IDS
+};
+
+struct ConnectionRecord
+{
+  uint64_t from_id;
+  uint64_t to_id;
+  double   weight;
+  uint32_t connection_type;
+  uint32_t reserved;
+};
+
+struct IndexNodeRecord
+{
+  double   x_min;
+  double   x_max;
+  double   y_min;
+  double   y_max;
+  Range    points;      // into INDEX_POINTS
+  uint64_t children[4]; // northwest, northeast, southwest, southeast; NONE for leaves
+};
+
+// Bounds checked access to records referenced from other records
+template<typename Record>
+const Record&
+at( std::span<const Record> records, uint64_t index )
+{
+  if( index >= records.size() )
+    throw std::runtime_error( "Compiled map: record index out of range" );
+  return records[index];
+}
+
+template<typename Record>
+std::span<const Record>
+sub_range( std::span<const Record> records, const Range& range )
+{
+  if( range.first > records.size() || range.count > records.size() - range.first )
+    throw std::runtime_error( "Compiled map: record range out of bounds" );
+  return records.subspan( range.first, range.count );
+}
+
+inline MapPoint
+to_map_point( const PointRecord& record )
+{
+  MapPoint point( record.x, record.y, record.parent_id );
+  point.s = record.s;
+  if( record.has_max_speed )
+    point.max_speed = record.max_speed;
+  return point;
+}
+
+} // namespace compiled
+
+// Serializes a map into the compiled map format
+std::vector<std::byte> compile_map( const Map& map );
+
+// Compiles a map and writes it to a file, throws std::runtime_error if the file cannot be written. The
+// file is written under file_location + ".tmp" and renamed over the target, mappings of the old file stay valid.
+void write_compiled_map( const Map& map, const std::string& file_location );
+
+// Read-only view on a compiled map held in memory, e.g. a memory mapped file or shared memory segment.
+//
+// Construction validates the header, the section bounds, the sort orders that lookups rely on and the
+// shape of the quadtree once; the records are then read in place.
+// Nearest point, window, lane and routing queries run directly on the records without building a
+// Map, so any number of processes can share one copy. The storage is kept alive as long as any copy
+// of the view exists.
+class CompiledMap
+{
+public:
+
+  using Boundary = Quadtree<MapPoint>::Boundary;
+
+  CompiledMap() {};
+
+  // Validates the buffer, throws std::runtime_error if it is not a compatible compiled map
+  CompiledMap( std::shared_ptr<const void> storage, const std::byte* data, size_t size );
+
+  // Memory maps a compiled map file read-only
+  static CompiledMap open( const std::string& file_location );
+
+  // Copies a buffer, e.g. one produced by compile_map
+  static CompiledMap from_buffer( std::vector<std::byte> buffer );
+
+  const compiled::Header&
+  get_header() const
+  {
+    return *reinterpret_cast<const compiled::Header*>( data );
+  }
+
+  size_t
+  size() const
+  {
+    return data_size;
+  }
+
+  std::span<const compiled::PointRecord>      points() const;
+  std::span<const compiled::SplineRecord>     splines() const;
+  std::span<const double>                     spline_values() const;
+  std::span<const compiled::LaneRecord>       lanes() const;
+  std::span<const compiled::RoadRecord>       roads() const;
+  std::span<const uint64_t>                   road_lane_ids() const;
+  std::span<const char>                       names() const;
+  std::span<const compiled::ConnectionRecord> connections() const;
+  std::span<const uint64_t>                   predecessors() const;
+  std::span<const compiled::IndexNodeRecord>  index_nodes() const;
+  std::span<const compiled::PointRecord>      index_points() const;
+
+  // Lane record with the given id, nullptr if the map has no such lane
+  const compiled::LaneRecord* find_lane( LaneID lane_id ) const;
+
+  // Points of a border range of a lane record
+  std::span<const compiled::PointRecord> get_points( const compiled::Range& range ) const;
+
+  // Copies a single lane out of the view, nullptr if the map has no such lane
+  std::shared_ptr<Lane> make_lane( LaneID lane_id ) const;
+
+  // Outgoing connections of a lane
+  std::span<const compiled::ConnectionRecord> get_successors( LaneID lane_id ) const;
+
+  // Ingoing connections of a lane
+  std::vector<const compiled::ConnectionRecord*> get_predecessors( LaneID lane_id ) const;
+
+  // Nearest indexed (center line) point accepted by the filter, same semantics as Quadtree::get_nearest_point
+  template<typename QueryPoint>
+  std::optional<MapPoint> get_nearest_point(
+    const QueryPoint& query_point, double& min_dist,
+    const std::function<bool( const compiled::PointRecord& )>& filter = []( const compiled::PointRecord& ) { return true; } ) const;
+
+  // Sorted ids of all lanes with a center point inside the window
+  std::vector<LaneID> get_lane_ids_in( const Boundary& window ) const;
+
+  // Dijkstra over the stored lane graph, same semantics as RoadGraph::find_path
+  std::deque<LaneID> find_path( LaneID from, LaneID to, bool allow_reverse = false ) const;
+
+  // Builds a regular Map from the view. Splines, resampled geometry and the spatial index are taken
+  // over as stored, nothing is refitted, but every lane, point and connection is copied into the Map and
+  // the compact lane graph is rebuilt. Query the view itself to avoid the copy.
+  Map to_map() const;
+
+private:
+
+  template<typename Record>
+  std::span<const Record> get_section( compiled::Section section ) const;
+
+  // Checks the sort orders that lookups rely on and that the quadtree is a tree, throws std::runtime_error
+  void validate_records() const;
+
+  std::shared_ptr<Lane> read_lane( const compiled::LaneRecord& record ) const;
+  Border                read_border( const compiled::BorderRecord& record ) const;
+  BorderSpline          read_spline( uint64_t spline_index ) const;
+
+  template<typename QueryPoint>
+  void find_nearest( uint64_t node_index, const QueryPoint& query_point, double& min_dist,
+                     const std::function<bool( const compiled::PointRecord& )>& filter,
+                     const compiled::PointRecord*&                              nearest ) const;
+
+  std::shared_ptr<const void> storage;
+  const std::byte*            data      = nullptr;
+  size_t                      data_size = 0;
+};
+
+template<typename QueryPoint>
+std::optional<MapPoint>
+CompiledMap::get_nearest_point( const QueryPoint& query_point, double& min_dist,
+                                const std::function<bool( const compiled::PointRecord& )>& filter ) const
+{
+  const compiled::PointRecord* nearest = nullptr;
+  if( !index_nodes().empty() )
+    find_nearest( 0, query_point, min_dist, filter, nearest );
+  if( !nearest )
+    return std::nullopt;
+  return compiled::to_map_point( *nearest );
+}
+
+template<typename QueryPoint>
+void
+CompiledMap::find_nearest( uint64_t node_index, const QueryPoint& query_point, double& min_dist,
+                           const std::function<bool( const compiled::PointRecord& )>& filter,
+                           const compiled::PointRecord*&                              nearest ) const
+{
+  const auto  nodes = index_nodes();
+  const auto& node  = nodes[node_index];
+
+  for( const auto& point : compiled::sub_range( index_points(), node.points ) )
+  {
+    if( !filter( point ) )
+      continue;
+    const double dist = std::hypot( point.x - query_point.x, point.y - query_point.y );
+    if( dist < min_dist )
+    {
+      min_dist = dist;
+      nearest  = &point;
+    }
+  }
+
+  if( node.children[0] == compiled::NONE )
+    return;
+
+  // Visit the children closest first and prune those farther away than the best point so far
+  std::pair<double, uint64_t> children[4];
+  for( size_t i = 0; i < 4; ++i )
+  {
+    const auto& child = compiled::at( nodes, node.children[i] );
+    Boundary    boundary{ child.x_min, child.x_max, child.y_min, child.y_max };
+    children[i] = { boundary.distance_to_point( query_point ), node.children[i] };
+  }
+  std::sort( std::begin( children ), std::end( children ) );
+  for( const auto& [dist_to_boundary, child_index] : children )
+  {
+    if( dist_to_boundary >= min_dist )
+      break;
+    find_nearest( child_index, query_point, min_dist, filter, nearest );
+  }
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,146 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+#include <algorithm>
+#include <deque>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "adore_map/compact_road_graph.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+struct ContractionConfig
+{
+  bool   allow_reverse         = false; // connections may also be traversed backwards, as in find_path
+  size_t witness_settle_limit  = 500;   // nodes a witness search settles before giving up and adding the shortcut
+  size_t priority_settle_limit = 20;    // same for the estimates that decide the contraction order
+  size_t thread_count          = 0;     // 0 = all cores
+};
+
+// Connection or shortcut in the hierarchy
+struct HierarchyEdge
+{
+  NodeIndex target = NO_NODE;
+  NodeIndex middle = NO_NODE; // node the shortcut bypasses, NO_NODE for connections of the lane graph
+  double    weight = 0.0;
+};
+
+// Contraction hierarchy over the lane graph for fast repeated point to point queries.
+//
+// Preprocessing removes ("contracts") the lanes one by one, least important first, and adds a shortcut
+// between two neighbours of a contracted lane whenever the path through it may be the only shortest one. A
+// query then runs a bidirectional Dijkstra that only climbs towards more important lanes on both sides,
+// settling a few hundred nodes on graphs where plain Dijkstra settles the whole map, and unpacks the
+// shortcuts of the path it found back into lanes.
+//
+// Lanes are contracted in batches of independent nodes on all threads. A rebuild after weight changes can
+// reuse the contraction order of the previous hierarchy, which skips the priority computation entirely.
+// Lane filters are not supported, queries always see the whole graph the hierarchy was built from.
+class ContractionHierarchy
+{
+public:
+
+  ContractionHierarchy() {};
+
+  // Contracts all lanes of the graph. With a previous hierarchy its lanes keep their order, lanes it does
+  // not know are contracted last in ascending id order.
+  static ContractionHierarchy build( const CompactRoadGraph& graph, const ContractionConfig& config = {},
+                                     const ContractionHierarchy* previous = nullptr );
+
+  // Shortest path with the same cost as RoadGraph::find_path with the allow_reverse setting of the hierarchy
+  std::deque<LaneID> find_path( LaneID from, LaneID to ) const;
+
+  // Writes the hierarchy to a binary file, throws std::runtime_error if the file cannot be written
+  void write( const std::string& file_location ) const;
+
+  // Reads a hierarchy written by write(), throws std::runtime_error if the file is missing or invalid
+  static ContractionHierarchy read( const std::string& file_location );
+
+  // Node of a lane, NO_NODE if the lane is not in the hierarchy
+  NodeIndex
+  find_node( LaneID lane_id ) const
+  {
+    auto it = std::lower_bound( lane_ids.begin(), lane_ids.end(), lane_id );
+    if( it == lane_ids.end() || *it != lane_id )
+      return NO_NODE;
+    return static_cast<NodeIndex>( it - lane_ids.begin() );
+  }
+
+  // Lanes from least to most important
+  std::vector<LaneID> get_order() const;
+
+  bool
+  allows_reverse() const
+  {
+    return allow_reverse;
+  }
+
+  size_t
+  node_count() const
+  {
+    return lane_ids.size();
+  }
+
+  size_t
+  edge_count() const
+  {
+    return upward_edges.size() + downward_edges.size();
+  }
+
+  size_t
+  shortcut_count() const
+  {
+    auto is_shortcut = []( const HierarchyEdge& edge ) { return edge.middle != NO_NODE; };
+    return std::count_if( upward_edges.begin(), upward_edges.end(), is_shortcut )
+         + std::count_if( downward_edges.begin(), downward_edges.end(), is_shortcut );
+  }
+
+private:
+
+  // Edges from a node to more important ones
+  std::span<const HierarchyEdge>
+  get_upward( NodeIndex node ) const
+  {
+    return { upward_edges.data() + upward_offsets[node], upward_edges.data() + upward_offsets[node + 1] };
+  }
+
+  // Edges into a node from more important ones, target is the node they come from
+  std::span<const HierarchyEdge>
+  get_downward( NodeIndex node ) const
+  {
+    return { downward_edges.data() + downward_offsets[node], downward_edges.data() + downward_offsets[node + 1] };
+  }
+
+  // Appends the lanes of the edge from one node to another through middle (NO_NODE for a connection),
+  // without the first one
+  void unpack( NodeIndex from, NodeIndex to, NodeIndex middle, std::deque<LaneID>& path ) const;
+
+  bool                       allow_reverse = false;
+  std::vector<LaneID>        lane_ids; // by node, sorted
+  std::vector<uint32_t>      ranks;    // by node, 0 for the first contracted
+  std::vector<uint32_t>      upward_offsets;
+  std::vector<HierarchyEdge> upward_edges;
+  std::vector<uint32_t>      downward_offsets;
+  std::vector<HierarchyEdge> downward_edges;
+};
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,93 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "adore_map/map_tiles.hpp"
+#include "adore_map/rasterizer.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Signed distance and its gradient at a point
+struct DistanceSample
+{
+  double distance = 0.0; // [m] positive inside the drivable area, negative outside
+  double dx       = 0.0; // gradient, points away from the road edge into the drivable area
+  double dy       = 0.0;
+};
+
+// Distances of one raster tile, sampled at the cell centers with one extra cell on every side so
+// interpolation never needs a neighbouring tile
+struct DistanceTile
+{
+  TileKey            key;
+  double             x_min = 0.0; // center of the first (padding) sample
+  double             y_min = 0.0;
+  size_t             size  = 0; // samples per side
+  std::vector<float> distances; // row major
+};
+
+// Signed distance field of the drivable area of a MapRaster.
+//
+// Tiles are computed on first use from the raster cells within max_distance around them, so distances
+// are continuous across tile borders, and cached afterwards. Distances are clamped to +-max_distance.
+// Lookups are bilinear and safe to run from many threads; the field keeps the raster it was built from,
+// so it stays valid while the map publishes newer rasters.
+class DistanceField
+{
+public:
+
+  DistanceField( std::shared_ptr<const MapRaster> raster, double max_distance = 5.0 );
+
+  double
+  get_distance( double x, double y ) const
+  {
+    return sample( x, y ).distance;
+  }
+
+  // Distance and gradient of the bilinear interpolation at a point
+  DistanceSample sample( double x, double y ) const;
+
+  // Tile at a key, computed now if it is not cached yet (e.g. to prepare the area around a route)
+  std::shared_ptr<const DistanceTile> get_tile( const TileKey& key ) const;
+
+  // Number of tiles computed so far
+  size_t cached_tiles() const;
+
+  double
+  get_max_distance() const
+  {
+    return max_distance;
+  }
+
+private:
+
+  std::shared_ptr<const DistanceTile> compute_tile( const TileKey& key ) const;
+
+  std::shared_ptr<const MapRaster> raster;
+  double                           max_distance = 5.0;
+  double                           resolution   = 0.0;
+
+  mutable std::shared_mutex                                                              mutex;
+  mutable std::unordered_map<TileKey, std::shared_ptr<const DistanceTile>, TileKeyHasher> tiles;
+};
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,55 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include "adore_map/lane.hpp"
+#include "adore_math/pose.h"
+
+namespace adore
+{
+namespace map
+{
+
+// Position relative to the center line of a lane
+struct FrenetCoordinate
+{
+  LaneID lane_id = 0;
+  double s       = 0.0; // along the center line, same parameter as the center points
+  double d       = 0.0; // signed distance to the center line, positive left of increasing s
+};
+
+// Point and derivatives with respect to s of the continuous lane center line
+struct CenterLineSample
+{
+  double x   = 0.0;
+  double y   = 0.0;
+  double dx  = 0.0;
+  double dy  = 0.0;
+  double ddx = 0.0;
+  double ddy = 0.0;
+};
+
+// Evaluates the lane center line at s. The center points are sampled as the mean of the inner and outer
+// border splines at the same fraction of their lengths, this evaluates that same curve between the samples.
+// Lanes without border splines fall back to the center polyline.
+CenterLineSample evaluate_center_line( const Lane& lane, double s );
+
+// Exact projection of (x, y) onto the lane center line, refined with Newton steps starting at s_guess.
+// Beyond the lane ends s is clamped and d is the signed distance to the end point.
+FrenetCoordinate project_onto_lane( const Lane& lane, double x, double y, double s_guess );
+
+// Pose at (s, d) relative to the lane center line, yaw points along increasing s
+math::Pose2d lane_frenet_to_pose( const Lane& lane, double s, double d );
+
+} // namespace map
+} // namespace adore
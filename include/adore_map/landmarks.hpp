@@ -0,0 +1,94 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "adore_map/lane.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+class CompactRoadGraph;
+
+struct LandmarkConfig
+{
+  size_t landmark_count = 16;
+  size_t thread_count   = 0; // 0 = all cores
+};
+
+// Landmark distances for A* lower bounds (ALT).
+//
+// A few landmark lanes are chosen far apart from each other, and the cost from every lane to every landmark
+// and back is stored as float, node-major so one lane's distances share a cache line. By the triangle
+// inequality d(v, t) >= d(L, t) - d(L, v) and d(v, t) >= d(v, L) - d(t, L) for every landmark L, which
+// bounds the remaining cost on road graphs far more tightly than straight line distances.
+//
+// The bounds stay valid when connections get more expensive or disappear (closures), since that only
+// makes true costs larger, so the index survives such changes without a rebuild. Cheaper or new
+// connections need a new index. Searches with allow_reverse use a separate table over the graph with
+// every connection usable in both directions.
+class LandmarkIndex
+{
+public:
+
+  static constexpr uint32_t NO_ROW = std::numeric_limits<uint32_t>::max();
+
+  LandmarkIndex() {};
+
+  // Picks the landmarks by farthest point selection and runs the distance searches on all threads
+  static LandmarkIndex build( const CompactRoadGraph& graph, const LandmarkConfig& config = {} );
+
+  // Row of a lane in the distance tables, NO_ROW if the lane was not in the graph
+  uint32_t
+  find_row( LaneID lane_id ) const
+  {
+    auto it = std::lower_bound( lane_ids.begin(), lane_ids.end(), lane_id );
+    if( it == lane_ids.end() || *it != lane_id )
+      return NO_ROW;
+    return static_cast<uint32_t>( it - lane_ids.begin() );
+  }
+
+  // Lower bound of the cost from one row to another, 0 if nothing is known, infinity if unreachable
+  double lower_bound( uint32_t from, uint32_t to, bool allow_reverse ) const;
+
+  const std::vector<LaneID>&
+  get_landmarks() const
+  {
+    return landmarks;
+  }
+
+  size_t
+  landmark_count() const
+  {
+    return landmarks.size();
+  }
+
+private:
+
+  std::vector<LaneID> lane_ids;      // by row, sorted
+  std::vector<LaneID> landmarks;     // landmark lanes
+  std::vector<float>  from_landmark; // [row * landmark_count + k], cost from landmark k to the lane
+  std::vector<float>  to_landmark;   // [row * landmark_count + k], cost from the lane to landmark k
+  std::vector<float>  either_way;    // [row * landmark_count + k], cost with connections usable both ways
+  std::vector<double> tolerance;     // per landmark, bound on the float rounding error of a difference
+};
+
+} // namespace map
+} // namespace adore
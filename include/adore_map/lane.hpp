@@ -29,6 +29,9 @@ namespace adore
 {
 namespace map
 {
+
+using LaneID = size_t;
+
 enum LaneMaterial
 {
   asphalt,
@@ -104,11 +107,17 @@ struct Lane
 
 struct Road
 {
-  std::string                               name;
-  std::unordered_set<std::shared_ptr<Lane>> lanes;
-  bool                                      one_way = false;
-  size_t                                    id;
-  RoadCategory                              category;
+  std::string         name;
+  std::vector<LaneID> lane_ids; // ids of the lanes on this road, resolved through Map::lanes
+  bool                one_way = false;
+  size_t              id;
+  RoadCategory        category;
+
+  // Adds a lane id if the road does not reference it yet
+  void add_lane( LaneID lane_id );
+
+  // Removes a lane id, returns false if the road did not reference it
+  bool remove_lane( LaneID lane_id );
 
   void set_category( const std::string& road_category_string );
 
@@ -116,7 +125,7 @@ struct Road
 
   Road( const std::string& name, size_t id, const std::string& road_category_string, bool one_way ) :
     name( name ),
-    lanes(), // Ensure all members are initialized in declaration order
+    lane_ids(), // Ensure all members are initialized in declaration order
     one_way( one_way ),
     id( id ),
     category( RoadCategory::unknown ) // Provide default category value
@@ -0,0 +1,100 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+#include <utility>
+#include <vector>
+
+#include "adore_map/lane.hpp"
+#include "adore_map/lane_store.hpp"
+#include "adore_map/map_point.hpp"
+#include "adore_map/quadtree.hpp"
+#include "adore_math/point.h"
+
+namespace adore
+{
+namespace map
+{
+
+// Outline of a lane: the inner border followed by the reversed outer border, closed implicitly
+struct LanePolygon
+{
+  LaneID                            lane_id = 0;
+  Quadtree<MapPoint>::Boundary      box{ 0.0, 0.0, 0.0, 0.0 };
+  std::vector<adore::math::Point2d> vertices;
+
+  // Even-odd test, points on an edge may count as inside or outside
+  bool contains( double x, double y ) const;
+};
+
+// Builds the outline of a lane from its interpolated borders, simplified so no dropped border point is
+// further than tolerance from the remaining edges
+LanePolygon make_lane_polygon( const Lane& lane, double tolerance );
+
+// Bounding volume hierarchy over lane polygons for exact point-in-lane queries.
+//
+// Boxes prune the candidates before the polygon test, so a query touches a handful of lanes no matter
+// how large the map is. The index is immutable once built and can be shared between threads.
+class LanePolygonIndex
+{
+public:
+
+  using Boundary = Quadtree<MapPoint>::Boundary;
+
+  LanePolygonIndex() {};
+
+  // Builds polygons for all lanes of a store on thread_count threads (0 = all cores)
+  static LanePolygonIndex build( const LaneStore& lanes, double tolerance = 0.05, size_t thread_count = 0 );
+
+  // Sorted ids of all lanes whose polygon contains the point
+  std::vector<LaneID> lanes_containing( double x, double y ) const;
+
+  // Sorted ids of all lanes whose bounding box overlaps the window
+  std::vector<LaneID> lanes_overlapping( const Boundary& window ) const;
+
+  // Polygon of a lane, nullptr if the lane is not indexed
+  const LanePolygon* find( LaneID lane_id ) const;
+
+  size_t
+  size() const
+  {
+    return polygons.size();
+  }
+
+private:
+
+  // Inner nodes reference two children, leaves a range of polygons
+  struct Node
+  {
+    Boundary box{ 0.0, 0.0, 0.0, 0.0 };
+    uint32_t left  = 0; // first child, or first polygon of a leaf
+    uint32_t right = 0; // second child, or polygon count of a leaf
+    bool     leaf  = false;
+  };
+
+  static constexpr size_t LEAF_SIZE = 4;
+
+  uint32_t build_node( size_t begin, size_t end );
+
+  template<typename Visitor>
+  void visit( const Boundary& window, Visitor&& visitor ) const;
+
+  std::vector<LanePolygon>                 polygons; // ordered so each leaf covers a contiguous range
+  std::vector<Node>                        nodes;    // nodes[0] is the root
+  std::vector<std::pair<LaneID, uint32_t>> by_id;    // sorted by lane id, index into polygons
+};
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,242 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "adore_map/lane.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Slot vector holding the lanes of a map.
+//
+// Lanes live in a contiguous vector of (lane id, lane) slots, so every lane has a dense index in
+// [0, size()). The lane id stays the stable external key; it is resolved to its slot through a
+// direct-address table indexed by lane id, which makes id -> lane lookups plain array accesses.
+// Lane ids are generated per load as small consecutive integers, which keeps the table compact. The
+// table only grows to ids below a few times the lane count (at least DIRECT_IDS), lanes with larger
+// ids are found through a hash map instead, so a single huge id cannot blow up the table.
+//
+// The interface mirrors the subset of std::map that the rest of the library uses (find, at, count,
+// operator[], iteration over (id, lane) pairs), except that iteration follows insertion order.
+class LaneStore
+{
+public:
+
+  using value_type     = std::pair<LaneID, std::shared_ptr<Lane>>;
+  using iterator       = std::vector<value_type>::iterator;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  static constexpr uint32_t NO_SLOT = std::numeric_limits<uint32_t>::max();
+
+  // Ids below this always go into the direct table, whatever the lane count
+  static constexpr size_t DIRECT_IDS = size_t( 1 ) << 16;
+
+  LaneStore() = default;
+
+  iterator
+  begin()
+  {
+    return slots.begin();
+  }
+
+  iterator
+  end()
+  {
+    return slots.end();
+  }
+
+  const_iterator
+  begin() const
+  {
+    return slots.begin();
+  }
+
+  const_iterator
+  end() const
+  {
+    return slots.end();
+  }
+
+  size_t
+  size() const
+  {
+    return slots.size();
+  }
+
+  bool
+  empty() const
+  {
+    return slots.empty();
+  }
+
+  void
+  reserve( size_t lane_count )
+  {
+    slots.reserve( lane_count );
+  }
+
+  void
+  clear()
+  {
+    slots.clear();
+    id_to_slot.clear();
+    sparse_slots.clear();
+  }
+
+  // Dense index of a lane, NO_SLOT if the lane is not stored
+  uint32_t
+  index_of( LaneID lane_id ) const
+  {
+    if( lane_id < id_to_slot.size() )
+      return id_to_slot[lane_id];
+    if( sparse_slots.empty() )
+      return NO_SLOT;
+    auto it = sparse_slots.find( lane_id );
+    return it == sparse_slots.end() ? NO_SLOT : it->second;
+  }
+
+  // Access by dense index, valid for indices in [0, size())
+  const value_type&
+  at_index( size_t index ) const
+  {
+    return slots[index];
+  }
+
+  iterator
+  find( LaneID lane_id )
+  {
+    uint32_t index = index_of( lane_id );
+    return index == NO_SLOT ? slots.end() : slots.begin() + index;
+  }
+
+  const_iterator
+  find( LaneID lane_id ) const
+  {
+    uint32_t index = index_of( lane_id );
+    return index == NO_SLOT ? slots.end() : slots.begin() + index;
+  }
+
+  size_t
+  count( LaneID lane_id ) const
+  {
+    return index_of( lane_id ) == NO_SLOT ? 0 : 1;
+  }
+
+  const std::shared_ptr<Lane>&
+  at( LaneID lane_id ) const
+  {
+    uint32_t index = index_of( lane_id );
+    if( index == NO_SLOT )
+      throw std::out_of_range( "LaneStore::at: no lane with id " + std::to_string( lane_id ) );
+    return slots[index].second;
+  }
+
+  // Same semantics as std::map::operator[]: creates an empty slot if the lane is not stored yet
+  std::shared_ptr<Lane>&
+  operator[]( LaneID lane_id )
+  {
+    uint32_t index = index_of( lane_id );
+    if( index == NO_SLOT )
+      index = append( lane_id, nullptr );
+    return slots[index].second;
+  }
+
+  // Inserts the lane under its own id, does nothing if that id is already stored
+  std::pair<iterator, bool>
+  insert( const std::shared_ptr<Lane>& lane )
+  {
+    uint32_t index = index_of( lane->id );
+    if( index != NO_SLOT )
+      return { slots.begin() + index, false };
+    index = append( lane->id, lane );
+    return { slots.begin() + index, true };
+  }
+
+  // Removes a lane by moving the last slot into its place, so dense indices of other lanes may change
+  size_t
+  erase( LaneID lane_id )
+  {
+    uint32_t index = index_of( lane_id );
+    if( index == NO_SLOT )
+      return 0;
+
+    if( index + 1 != slots.size() )
+    {
+      slots[index] = std::move( slots.back() );
+      set_slot( slots[index].first, index );
+    }
+    slots.pop_back();
+    set_slot( lane_id, NO_SLOT );
+    return 1;
+  }
+
+private:
+
+  std::vector<value_type>              slots;
+  std::vector<uint32_t>                id_to_slot;   // direct table for small ids
+  std::unordered_map<LaneID, uint32_t> sparse_slots; // ids beyond the direct table
+
+  // Records the slot of a lane (NO_SLOT to forget it) wherever its id is kept
+  void
+  set_slot( LaneID lane_id, uint32_t index )
+  {
+    if( lane_id < id_to_slot.size() )
+      id_to_slot[lane_id] = index;
+    else if( index == NO_SLOT )
+      sparse_slots.erase( lane_id );
+    else
+      sparse_slots[lane_id] = index;
+  }
+
+  uint32_t
+  append( LaneID lane_id, const std::shared_ptr<Lane>& lane )
+  {
+    if( lane_id >= id_to_slot.size() && lane_id < std::max( DIRECT_IDS, 4 * ( slots.size() + 1 ) ) )
+    {
+      id_to_slot.resize( lane_id + 1, NO_SLOT );
+
+      // Ids that were too large for the table before may fit now
+      for( auto it = sparse_slots.begin(); it != sparse_slots.end(); )
+      {
+        if( it->first < id_to_slot.size() )
+        {
+          id_to_slot[it->first] = it->second;
+          it                    = sparse_slots.erase( it );
+        }
+        else
+          ++it;
+      }
+    }
+
+    uint32_t index = static_cast<uint32_t>( slots.size() );
+    set_slot( lane_id, index );
+    slots.emplace_back( lane_id, lane );
+    return index;
+  }
+};
+
+} // namespace map
+} // namespace adore
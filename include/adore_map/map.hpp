@@ -21,14 +21,23 @@
 #include <map>
 #include <optional>
 #include <set>
+#include <span>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "adore_map/border.hpp"
+#include "adore_map/boundary_index.hpp"
+#include "adore_map/compact_road_graph.hpp"
+#include "adore_map/frenet.hpp"
 #include "adore_map/lane.hpp"
+#include "adore_map/lane_polygons.hpp"
+#include "adore_map/lane_store.hpp"
+#include "adore_map/map_tiles.hpp"
+#include "adore_map/parallel.hpp"
 #include "adore_map/quadtree.hpp"
 #include "adore_map/r2s_parser.h"
+#include "adore_map/rasterizer.hpp"
 #include "adore_map/road_graph.hpp"
 #include "adore_math/distance.h"
 
@@ -39,6 +48,11 @@ namespace map
 
 
 // The Map class definition
+//
+// Thread safety: const member functions, and the free functions taking a const Map (get_map_distance,
+// get_map_distances, Route), only read the map. Lanes, borders, splines, the quadtree and the lane graph keep no hidden
+// mutable state, so any number of threads may query one map concurrently as long as no thread modifies
+// it at the same time. To change a map while it is being queried, publish a new version through MapHandle.
 class Map
 {
 public:
@@ -47,13 +61,59 @@ public:
   Map() {};
   Map( const std::string& map_file_location );
 
-  Quadtree<MapPoint>                      quadtree;
-  RoadGraph                               lane_graph;
-  std::map<size_t, Road>                  roads;
-  std::map<size_t, std::shared_ptr<Lane>> lanes;
+  Quadtree<MapPoint>     quadtree;
+  RoadGraph              lane_graph;
+  std::map<size_t, Road> roads;
+  LaneStore              lanes;
+
+  // Optional fixed-grid partition of the lanes, see build_tiles(). insert_lane and remove_lane rebuild the affected tiles.
+  std::shared_ptr<const TileGrid> tiles;
+
+  // Optional polygon hierarchy of the lanes, see build_lane_polygons(). Dropped by insert_lane and remove_lane.
+  std::shared_ptr<const LanePolygonIndex> lane_polygons;
+
+  // Optional drivable area raster, see build_raster(). insert_lane and remove_lane re-render the affected tiles.
+  std::shared_ptr<const MapRaster> raster;
+
+  // Optional index of the inner and outer lane borders, see build_boundaries(). Dropped by insert_lane and remove_lane.
+  std::shared_ptr<const BoundaryIndex> boundaries;
 
   double get_lane_speed_limit( size_t lane_id ) const;
 
+  // Adds a lane, indexes its center points and registers it with its road (if the road exists). A lane with an
+  // id that is already stored replaces the old one in all indexes and keeps its connections.
+  // Connections are not inferred, add them to lane_graph separately.
+  void insert_lane( const std::shared_ptr<Lane>& lane );
+
+  // Removes a lane with its index points, road membership and connections, returns false if absent
+  bool remove_lane( LaneID lane_id );
+
+  // Partitions the map into square tiles so window queries union a few tiles instead of walking the quadtree
+  void build_tiles( double tile_size = 100.0, size_t thread_count = 0 );
+
+  // Sorted ids of all lanes with a center point inside the window
+  std::vector<LaneID> get_lane_ids_in( const Quadtree<MapPoint>::Boundary& window ) const;
+
+  // Builds simplified lane outlines (within tolerance of the borders) and a bounding volume hierarchy over them
+  void build_lane_polygons( double tolerance = 0.05, size_t thread_count = 0 );
+
+  // Renders the lane outlines into tiled occupancy and lane id grids for constant time point lookups
+  void build_raster( const RasterConfig& config = RasterConfig(), size_t thread_count = 0 );
+
+  // Indexes the lane borders as lane dividers and road edges, reusing lane_polygons if they were built
+  void build_boundaries( const BoundaryConfig& config = BoundaryConfig(), size_t thread_count = 0 );
+
+  // Sorted ids of all lanes whose outline contains the point. Without lane_polygons the lanes near the
+  // point are outlined on the fly, which is exact but much slower.
+  std::vector<LaneID> lanes_containing( double x, double y ) const;
+
+  template<typename Point>
+  std::vector<LaneID>
+  lanes_containing( const Point& point ) const
+  {
+    return lanes_containing( point.x, point.y );
+  }
+
   template<typename CenterPoint>
   Map
   get_submap( const CenterPoint& center, double width, double height ) const
@@ -71,17 +131,9 @@ public:
     submap.quadtree.boundary = query_boundary;
     submap.quadtree.capacity = this->quadtree.capacity; // Copy capacity
 
-    // Query the quadtree to find all points within the boundary
-    std::vector<MapPoint> found_points;
-    this->quadtree.query( query_boundary, found_points );
-
-
-    // Collect unique lane IDs from the found points
-    std::unordered_set<size_t> unique_lane_ids;
-    for( const auto& point : found_points )
-    {
-      unique_lane_ids.insert( point.parent_id );
-    }
+    // Collect unique lane IDs from the points within the boundary
+    const auto                 lane_ids_in_window = get_lane_ids_in( query_boundary );
+    std::unordered_set<size_t> unique_lane_ids( lane_ids_in_window.begin(), lane_ids_in_window.end() );
 
     // Copy the lanes into the submap
     for( const auto& lane_id : unique_lane_ids )
@@ -92,7 +144,7 @@ public:
 
         // Deep copy the Lane
         std::shared_ptr<Lane> copied_lane = std::make_shared<Lane>( *it->second );
-        submap.lanes[lane_id]             = copied_lane;
+        submap.lanes.insert( copied_lane );
 
         // Insert all MapPoints from the lane's borders into the submap's quadtree
         const Borders& borders = copied_lane->borders;
@@ -112,14 +164,14 @@ public:
           {
             Road copied_road = road_it->second;
             // Clear the lanes in the copied road and add the copied lane
-            copied_road.lanes.clear();
-            copied_road.lanes.insert( copied_lane );
+            copied_road.lane_ids.clear();
+            copied_road.add_lane( lane_id );
             submap.roads[road_it->first] = copied_road;
           }
           else
           {
             // Add the lane to the existing road in the submap
-            submap.roads[road_it->first].lanes.insert( copied_lane );
+            submap.roads[road_it->first].add_lane( lane_id );
           }
         }
       }
@@ -132,7 +184,7 @@ public:
 
   template<typename Point>
   bool
-  is_point_on_road( const Point& point )
+  is_point_on_road( const Point& point ) const
   {
     double min_dist   = std::numeric_limits<double>::max();
     auto   near_point = quadtree.get_nearest_point( point, min_dist );
@@ -141,13 +193,14 @@ public:
       return false;
 
 
-    if( lanes.count( near_point->parent_id ) == 0 )
+    auto lane_it = lanes.find( near_point->parent_id );
+    if( lane_it == lanes.end() )
     {
       std::cerr << "is_point_on_road failed to get width from lane - nearest point not in lanes" << std::endl;
       return false;
     }
 
-    double width = lanes[near_point->parent_id]->get_width( near_point->s );
+    double width = lane_it->second->get_width( near_point->s );
     if( min_dist < width / 2 )
     {
       return true;
@@ -157,7 +210,7 @@ public:
   
   template<typename Point>
   std::optional<double>
-  get_nearest_lane_width(const Point& point )
+  get_nearest_lane_width( const Point& point ) const
   {
     double min_dist   = std::numeric_limits<double>::max();
     auto   near_point = quadtree.get_nearest_point( point, min_dist );
@@ -165,67 +218,83 @@ public:
     if( !near_point )
       return {};
 
-    if( lanes.count( near_point->parent_id ) == 0 )
+    auto lane_it = lanes.find( near_point->parent_id );
+    if( lane_it == lanes.end() )
       return {};
 
-    double lane_width = lanes[near_point->parent_id]->get_width( near_point->s );
+    double lane_width = lane_it->second->get_width( near_point->s );
     return lane_width;
   }
 
+  // Distance to the continuous center line of the nearest lane
   template<typename Point>
   double
   get_distance_from_nearest_center( const Point& query_point ) const
+  {
+    auto frenet = to_frenet( query_point );
+    if( !frenet )
+      return std::numeric_limits<double>::max();
+    return std::fabs( frenet->d );
+  }
+
+  // Exact projection onto the center line of the lane owning the nearest center point
+  template<typename Point>
+  std::optional<FrenetCoordinate>
+  to_frenet( const Point& point ) const
   {
     double min_dist = std::numeric_limits<double>::max();
-    auto   nearest  = quadtree.get_nearest_point( query_point, min_dist );
+    auto   nearest  = quadtree.get_nearest_point( point, min_dist );
     if( !nearest )
-      return min_dist;
-
-    return math::distance_2d( *nearest, query_point );
+      return {};
 
     auto lane_it = lanes.find( nearest->parent_id );
-    if( lane_it == lanes.end() )
-      return min_dist;
-
-    const auto& lane = lane_it->second;
-    if( !lane->borders.center.spline.has_value() )
-      return min_dist;
-
-    const auto& center_spline = lane->borders.center.spline.value();
+    if( lane_it == lanes.end() || !lane_it->second )
+      return {};
 
-    const auto& spline = lane->borders.center.spline.value();
+    return project_onto_lane( *lane_it->second, point.x, point.y, nearest->s );
+  }
 
-    const double dx   = spline.get_x_derivative_at_s( nearest->s );
-    const double dy   = spline.get_y_derivative_at_s( nearest->s );
-    const double norm = std::sqrt( dx * dx + dy * dy );
-    if( norm < 1e-6 )
-      return min_dist;
+  // Projects many points (anything with x and y) on thread_count threads (0 = all cores)
+  template<typename Point>
+  std::vector<std::optional<FrenetCoordinate>>
+  to_frenet_batch( std::span<const Point> points, size_t thread_count = 1 ) const
+  {
+    std::vector<std::optional<FrenetCoordinate>> result( points.size() );
+    parallel_for( points.size(), thread_count, [&]( size_t i ) { result[i] = to_frenet( points[i] ); } );
+    return result;
+  }
 
-    const double nx = dx / norm;
-    const double ny = dy / norm;
+  template<typename Point>
+  std::vector<std::optional<FrenetCoordinate>>
+  to_frenet_batch( const std::vector<Point>& points, size_t thread_count = 1 ) const
+  {
+    return to_frenet_batch( std::span<const Point>( points ), thread_count );
+  }
 
-    const double px = nearest->x;
-    const double py = nearest->y;
-    const double qx = query_point.x;
-    const double qy = query_point.y;
+  // Pose at a Frenet coordinate, yaw along increasing s. Empty if the lane is not part of the map.
+  std::optional<math::Pose2d> from_frenet( const FrenetCoordinate& frenet ) const;
 
-    const double dxq = qx - px;
-    const double dyq = qy - py;
+private:
 
-    const double nx_perp = -ny;
-    const double ny_perp = nx;
+  // Re-renders the raster tiles a lane covers or covered, if a raster was built
+  void update_raster( LaneID lane_id );
 
-    // Signed distance from query point to line
-    const double signed_distance = dxq * nx_perp + dyq * ny_perp;
+  // Drops the lane positions recorded by the lane graph if they place this lane elsewhere, and rebuilds
+  // the compact graph from the current lanes if there is one. Call after the lane is in the store.
+  void forget_moved_position( const Lane& lane );
 
-    return std::fabs( signed_distance );
-  }
+  // Rebuilds the grid tiles a lane passes through after it was inserted or removed, if tiles were built
+  void update_tiles( const Lane& lane );
 };
 
+// Length along the lanes of the shortest route between two points, with the weights of an overlay if one is
+// given (see WeightOverlay), infinity if there is no route
 inline double
-get_map_distance( const MapPoint& start_point, const MapPoint& end_point, const std::shared_ptr<Map>& map )
+get_map_distance( const MapPoint& start_point, const MapPoint& end_point, const std::shared_ptr<const Map>& map,
+                  const WeightOverlay* overlay = nullptr )
 {
-  auto lane_id_route = map->lane_graph.find_path( start_point.parent_id, end_point.parent_id, /* allow_reverse */ true );
+  auto lane_id_route = overlay ? map->lane_graph.find_path( start_point.parent_id, end_point.parent_id, /* allow_reverse */ true, *overlay )
+                               : map->lane_graph.find_path( start_point.parent_id, end_point.parent_id, /* allow_reverse */ true );
   if( lane_id_route.empty() )
   {
     std::cerr << "Failed to find route from " << start_point.parent_id << " to " << end_point.parent_id << std::endl;
@@ -265,6 +334,14 @@ get_map_distance( const MapPoint& start_point, const MapPoint& end_point, const
   return total_distance;
 }
 
+// Distances as get_map_distance from every start point to every end point, indexed [start][end], infinity
+// where there is no route. Runs one search per distinct start lane on up to thread_count threads (0 = all
+// cores), each ending once all end lanes are reached, instead of one search per pair. Routes follow the
+// weights of an overlay if one is given.
+std::vector<std::vector<double>> get_map_distances( const std::vector<MapPoint>& start_points, const std::vector<MapPoint>& end_points,
+                                                    const std::shared_ptr<const Map>& map, size_t thread_count = 0,
+                                                    const WeightOverlay* overlay = nullptr );
+
 
 } // namespace map
 } // namespace adore
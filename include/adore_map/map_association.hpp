@@ -0,0 +1,62 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <span>
+#include <vector>
+
+#include "adore_map/map.hpp"
+#include "adore_map/parallel.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Relation of an object pose to its nearest lane
+struct LaneAssociation
+{
+  bool   found              = false; // false if the map has no lane points
+  LaneID lane_id            = 0;
+  double s                  = 0.0; // along the lane center line, same projection as Map::to_frenet
+  double lateral_offset     = 0.0; // signed distance to the center line, positive left of the driving direction
+  double lane_width         = 0.0; // same as Map::get_nearest_lane_width
+  bool   on_road            = false; // same as Map::is_point_on_road
+  double heading_difference = 0.0; // object yaw minus lane heading in driving direction, in [-pi, pi]
+};
+
+// Associates one pose with the map using a single nearest point search and lane lookup
+LaneAssociation associate_pose( const Map& map, double x, double y, double yaw );
+
+// Associates many poses (anything with x, y and yaw) with the map, on thread_count threads (0 = all cores).
+// The map must not be modified while the call runs.
+template<typename Pose>
+std::vector<LaneAssociation>
+associate_poses( const Map& map, std::span<const Pose> poses, size_t thread_count = 1 )
+{
+  std::vector<LaneAssociation> associations( poses.size() );
+  parallel_for( poses.size(), thread_count, [&]( size_t i ) {
+    associations[i] = associate_pose( map, poses[i].x, poses[i].y, poses[i].yaw );
+  } );
+  return associations;
+}
+
+template<typename Pose>
+std::vector<LaneAssociation>
+associate_poses( const Map& map, const std::vector<Pose>& poses, size_t thread_count = 1 )
+{
+  return associate_poses( map, std::span<const Pose>( poses ), thread_count );
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,117 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include "adore_map/map.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Immutable map version as handed out to readers
+struct MapSnapshot
+{
+  std::shared_ptr<const Map> map;
+  uint64_t                   version = 0;
+};
+
+// Publishes immutable map versions to concurrent readers, RCU style.
+//
+// Readers take a snapshot and query it for as long as they like, a snapshot never changes and stays
+// alive until its last reader drops it. Writers derive the next version from the current one and
+// swap it in atomically; readers are never blocked while a writer builds a version.
+//
+// update() copies the current map shallowly: all lanes, and the quadtree nodes not touched by the
+// update, are shared with the previous version. An updater must therefore never modify a lane in
+// place. To change a lane, insert a new Lane object under its id. insert_lane and remove_lane patch
+// the tiles and the raster copy on write, so the previous version keeps its own. They drop the lane
+// polygon and boundary indexes, which must be built again if needed.
+class MapHandle
+{
+public:
+
+  MapHandle() :
+    current( std::make_shared<const MapSnapshot>( MapSnapshot{ std::make_shared<const Map>(), 0 } ) )
+  {}
+
+  explicit MapHandle( std::shared_ptr<const Map> initial_map ) :
+    current( std::make_shared<const MapSnapshot>( MapSnapshot{ std::move( initial_map ), 0 } ) )
+  {}
+
+  MapHandle( const MapHandle& )            = delete;
+  MapHandle& operator=( const MapHandle& ) = delete;
+
+  // Current map version, safe to call from any thread
+  MapSnapshot
+  snapshot() const
+  {
+    return *current.load( std::memory_order_acquire );
+  }
+
+  std::shared_ptr<const Map>
+  get() const
+  {
+    return current.load( std::memory_order_acquire )->map;
+  }
+
+  uint64_t
+  get_version() const
+  {
+    return current.load( std::memory_order_acquire )->version;
+  }
+
+  // Replaces the map with a new version built elsewhere, returns its version number
+  uint64_t
+  publish( std::shared_ptr<const Map> next_map )
+  {
+    std::lock_guard<std::mutex> lock( writer_mutex );
+    return swap_in( std::move( next_map ) );
+  }
+
+  // Applies updater( Map& ) to a copy of the current version and publishes the result. Writers are
+  // serialized, readers keep using the previous version until they take a new snapshot.
+  template<typename Updater>
+  MapSnapshot
+  update( Updater&& updater )
+  {
+    std::lock_guard<std::mutex> lock( writer_mutex );
+
+    auto next_map = std::make_shared<Map>( *current.load( std::memory_order_acquire )->map );
+    updater( *next_map );
+
+    const uint64_t version = swap_in( std::move( next_map ) );
+    return { current.load( std::memory_order_acquire )->map, version };
+  }
+
+private:
+
+  uint64_t
+  swap_in( std::shared_ptr<const Map> next_map )
+  {
+    const uint64_t version = current.load( std::memory_order_relaxed )->version + 1;
+    current.store( std::make_shared<const MapSnapshot>( MapSnapshot{ std::move( next_map ), version } ), std::memory_order_release );
+    return version;
+  }
+
+  std::atomic<std::shared_ptr<const MapSnapshot>> current;
+  std::mutex                                      writer_mutex;
+};
+
+} // namespace map
+} // namespace adore
@@ -15,6 +15,7 @@
 
 #include <string>
 
+#include "adore_map/compiled_map.hpp"
 #include "adore_map/map.hpp"
 #include "adore_map/r2s_parser.h"
 #include "adore_map/map_downloader.hpp"
@@ -47,6 +48,12 @@ public:
 
   static Map load_from_file( const std::string& map_file_location, bool allow_lane_changes = true, bool ignore_non_driving = false );
 
+  // Loads a map compiled by adore_map_compile (.admap). The file is memory mapped and its geometry,
+  // splines, spatial index and lane graph are taken over as stored, nothing is parsed or refitted. The
+  // result is a full copy (CompiledMap::to_map), the mapping is released afterwards. For loads without
+  // copying, query a CompiledMap directly.
+  static Map load_compiled( const std::string& compiled_map_location );
+
   /** @brief Downloads map data from a WFS server and constructs a Map object
    * @param[in] downloader MapDownloader instance to use for downloading map data
    * @param[in] reference_lines_layer_name Name of the layer containing reference lines
@@ -73,7 +80,7 @@ private:
   static std::vector<BorderWithOffset> get_clipped_borders( const std::vector<Border>& borders, const Border& ref_line_clipped,
                                                             double s_start, double s_end );
 
-  static void make_lane( const BorderWithOffset& inner_border, const BorderWithOffset& outer_border, Road& road, Map& map,
+  static void make_lane( const BorderWithOffset& inner_border, const BorderWithOffset& outer_border, LaneID lane_id, Road& road, Map& map,
                          const std::unordered_map<int, std::shared_ptr<r2s::BorderDataR2SL>>& id_to_border );
 
   static double compute_lateral_offset( const Border& reference_line, const MapPoint& target_point );
@@ -83,8 +90,6 @@ private:
 
   static void set_quadtree_bounds( Map& map, const odr::OpenDriveMap& xodr_map );
 
-  static size_t generate_lane_id();
-
   // Constants
   constexpr static double LANE_CONNECTION_DIST = 1.2;
   constexpr static double MIN_LANE_LENGTH      = 0.5;
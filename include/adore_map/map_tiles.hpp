@@ -0,0 +1,132 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "adore_map/lane_store.hpp"
+#include "adore_map/map_point.hpp"
+#include "adore_map/quadtree.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Integer cell coordinates of a tile in a TileGrid
+struct TileKey
+{
+  int64_t ix = 0;
+  int64_t iy = 0;
+
+  bool
+  operator==( const TileKey& other ) const
+  {
+    return ix == other.ix && iy == other.iy;
+  }
+};
+
+struct TileKeyHasher
+{
+  std::size_t
+  operator()( const TileKey& key ) const
+  {
+    // splitmix-style mixing of both coordinates
+    uint64_t h  = static_cast<uint64_t>( key.ix ) * 0x9E3779B97F4A7C15ULL;
+    h          ^= static_cast<uint64_t>( key.iy ) + 0x7F4A7C159E3779B9ULL + ( h << 6 ) + ( h >> 2 );
+    return static_cast<std::size_t>( h );
+  }
+};
+
+// One cell of a TileGrid: the lanes with center points in the cell and a local index of those points
+struct MapTile
+{
+  TileKey                      key;
+  Quadtree<MapPoint>::Boundary boundary{ 0.0, 0.0, 0.0, 0.0 };
+  std::vector<LaneID>          lane_ids; // sorted, unique
+  Quadtree<MapPoint>           index;
+};
+
+// Fixed grid partition of a map into square tiles.
+//
+// Every lane center point belongs to exactly one tile. Tiles are immutable once built and held by
+// shared pointer, so they can be built in parallel, cached and swapped in individually (e.g. for
+// lazily loaded regions of a large map). Window queries union the few tiles overlapping the window
+// instead of walking the global quadtree.
+class TileGrid
+{
+public:
+
+  using Boundary = Quadtree<MapPoint>::Boundary;
+
+  TileGrid() {};
+  TileGrid( double tile_size, double origin_x = 0.0, double origin_y = 0.0 );
+
+  // Partitions all lanes of a store into tiles, building the tiles on thread_count threads (0 = all cores)
+  static TileGrid build( const LaneStore& lanes, double tile_size, size_t thread_count = 0 );
+
+  // Builds a single tile from the given lanes, e.g. to refresh or lazily load one cell
+  std::shared_ptr<const MapTile> build_tile( const TileKey& key, const LaneStore& lanes, const std::vector<LaneID>& lane_ids ) const;
+
+  double
+  get_tile_size() const
+  {
+    return tile_size;
+  }
+
+  size_t
+  size() const
+  {
+    return tiles.size();
+  }
+
+  TileKey
+  get_key( double x, double y ) const
+  {
+    return { static_cast<int64_t>( std::floor( ( x - origin_x ) / tile_size ) ),
+             static_cast<int64_t>( std::floor( ( y - origin_y ) / tile_size ) ) };
+  }
+
+  Boundary get_tile_boundary( const TileKey& key ) const;
+
+  // Tile at a key, nullptr if no lane passes through that cell
+  std::shared_ptr<const MapTile> get_tile( const TileKey& key ) const;
+
+  // Adds or replaces a tile
+  void set_tile( const std::shared_ptr<const MapTile>& tile );
+
+  // Drops the tile at a key, e.g. after its last lane was removed
+  void remove_tile( const TileKey& key );
+
+  // Tiles overlapping a window
+  std::vector<std::shared_ptr<const MapTile>> get_tiles( const Boundary& window ) const;
+
+  // Sorted ids of all lanes with a center point inside the window
+  std::vector<LaneID> get_lane_ids( const Boundary& window ) const;
+
+private:
+
+  double tile_size = 100.0;
+  double origin_x  = 0.0;
+  double origin_y  = 0.0;
+
+  std::unordered_map<TileKey, std::shared_ptr<const MapTile>, TileKeyHasher> tiles;
+};
+
+} // namespace map
+} // namespace adore
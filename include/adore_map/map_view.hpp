@@ -0,0 +1,150 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "adore_map/map.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Submap that shares the lanes, spatial index and lane graph of its parent map.
+//
+// A view only stores the ids of the lanes inside its window. Lanes are handed out as the parent's
+// immutable lane objects, spatial and graph queries run on the parent's quadtree and lane graph
+// restricted to those ids. Creating a view therefore costs time proportional to the number of
+// points in the window, not to the geometry of the lanes. The parent map must not be modified
+// while views on it are in use.
+class MapView
+{
+public:
+
+  using Boundary = Quadtree<MapPoint>::Boundary;
+
+  MapView() {};
+  MapView( const std::shared_ptr<const Map>& parent_map, const Boundary& boundary, std::vector<LaneID> lane_ids );
+
+  // View on all lanes with center points inside the given window
+  template<typename CenterPoint>
+  static MapView create( const std::shared_ptr<const Map>& parent_map, const CenterPoint& center, double width, double height );
+
+  const std::shared_ptr<const Map>&
+  get_parent() const
+  {
+    return parent;
+  }
+
+  const Boundary&
+  get_boundary() const
+  {
+    return boundary;
+  }
+
+  // Sorted ids of the lanes in this view
+  const std::vector<LaneID>&
+  get_lane_ids() const
+  {
+    return lane_ids;
+  }
+
+  size_t
+  size() const
+  {
+    return lane_ids.size();
+  }
+
+  bool
+  empty() const
+  {
+    return lane_ids.empty();
+  }
+
+  bool contains_lane( LaneID lane_id ) const;
+
+  // Shared lane of the parent map, nullptr if the lane is not part of the view
+  std::shared_ptr<const Lane> get_lane( LaneID lane_id ) const;
+
+  // Successors of a lane that are part of the view
+  std::vector<LaneID> get_successors( LaneID lane_id ) const;
+
+  // Shortest path over the parent lane graph that only uses lanes of the view
+  std::deque<LaneID> find_path( LaneID from, LaneID to, bool allow_reverse = false ) const;
+
+  // Nearest center point of a lane in the view
+  template<typename Point>
+  std::optional<MapPoint> get_nearest_point( const Point& point, double& min_dist ) const;
+
+  // Calls visitor for every center point of a view lane inside range
+  template<typename Visitor>
+  void visit_points( const Boundary& range, Visitor&& visitor ) const;
+
+  // Materializes the view as a standalone Map; lanes are shared with the parent, not copied
+  Map to_map() const;
+
+private:
+
+  std::shared_ptr<const Map> parent;
+  Boundary                   boundary{ 0.0, 0.0, 0.0, 0.0 };
+  std::vector<LaneID>        lane_ids;
+};
+
+template<typename CenterPoint>
+MapView
+MapView::create( const std::shared_ptr<const Map>& parent_map, const CenterPoint& center, double width, double height )
+{
+  Boundary query_boundary;
+  query_boundary.x_min = center.x - width / 2.0;
+  query_boundary.x_max = center.x + width / 2.0;
+  query_boundary.y_min = center.y - height / 2.0;
+  query_boundary.y_max = center.y + height / 2.0;
+
+  std::vector<LaneID> found_lane_ids;
+  if( parent_map )
+    found_lane_ids = parent_map->get_lane_ids_in( query_boundary );
+
+  return MapView( parent_map, query_boundary, std::move( found_lane_ids ) );
+}
+
+template<typename Point>
+std::optional<MapPoint>
+MapView::get_nearest_point( const Point& point, double& min_dist ) const
+{
+  if( !parent || lane_ids.empty() )
+    return std::nullopt;
+
+  return parent->quadtree.get_nearest_point( point, min_dist, [this]( const MapPoint& p ) { return contains_lane( p.parent_id ); } );
+}
+
+template<typename Visitor>
+void
+MapView::visit_points( const Boundary& range, Visitor&& visitor ) const
+{
+  if( !parent )
+    return;
+
+  parent->quadtree.visit( range, [&]( const MapPoint& p ) {
+    if( contains_lane( p.parent_id ) )
+      visitor( p );
+  } );
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,88 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace adore
+{
+namespace map
+{
+
+// Number of worker threads to use for a requested thread count, 0 meaning "all cores"
+inline size_t
+resolve_thread_count( size_t requested_threads, size_t work_items )
+{
+  size_t threads = requested_threads;
+  if( threads == 0 )
+    threads = std::max<size_t>( 1, std::thread::hardware_concurrency() );
+  return std::max<size_t>( 1, std::min( threads, work_items ) );
+}
+
+// Calls task( i ) for every i in [0, count) on up to thread_count threads (0 = all cores).
+// Items are handed out one at a time, so uneven work per item balances itself. The first
+// exception thrown by a task is rethrown on the calling thread after all workers finished.
+template<typename Task>
+void
+parallel_for( size_t count, size_t thread_count, Task&& task )
+{
+  if( count == 0 )
+    return;
+
+  const size_t threads = resolve_thread_count( thread_count, count );
+  if( threads == 1 )
+  {
+    for( size_t i = 0; i < count; ++i )
+      task( i );
+    return;
+  }
+
+  std::atomic<size_t> next_item{ 0 };
+  std::exception_ptr  first_error;
+  std::mutex          error_mutex;
+
+  auto worker = [&]() {
+    for( size_t i = next_item++; i < count; i = next_item++ )
+    {
+      try
+      {
+        task( i );
+      }
+      catch( ... )
+      {
+        std::lock_guard<std::mutex> lock( error_mutex );
+        if( !first_error )
+          first_error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  workers.reserve( threads - 1 );
+  for( size_t t = 1; t < threads; ++t )
+    workers.emplace_back( worker );
+  worker();
+  for( auto& thread : workers )
+    thread.join();
+
+  if( first_error )
+    std::rethrow_exception( first_error );
+}
+
+} // namespace map
+} // namespace adore
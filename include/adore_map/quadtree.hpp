@@ -15,9 +15,12 @@
 #include <cmath>
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "adore_math/distance.h"
 
@@ -74,6 +77,14 @@ public:
     }
   };
 
+  // Contents of a single node, as used to flatten and restore a tree
+  struct NodeData
+  {
+    Boundary           boundary;
+    std::vector<Point> points;
+    bool               divided = false;
+  };
+
   // Constructor for Quadtree node
   Quadtree( const Boundary& boundary, size_t capacity ) :
     boundary( boundary ),
@@ -103,7 +114,61 @@ public:
     }
 
     // Now insert the new point into appropriate child
-    return ( northwest->insert( point ) || northeast->insert( point ) || southwest->insert( point ) || southeast->insert( point ) );
+    return ( insert_into_child( northwest, point ) || insert_into_child( northeast, point ) || insert_into_child( southwest, point )
+             || insert_into_child( southeast, point ) );
+  }
+
+  // Remove one point at the location of the given point that is accepted by the filter
+  bool
+  remove(
+    const Point& point,
+    // default: accept all points
+    const std::function<bool( const Point& )>& filter = []( const Point& ) { return true; } )
+  {
+    if( !boundary.contains( point ) )
+    {
+      return false;
+    }
+
+    auto it = std::find_if( points.begin(), points.end(),
+                            [&]( const Point& p ) { return p.x == point.x && p.y == point.y && filter( p ); } );
+    if( it != points.end() )
+    {
+      points.erase( it );
+      return true;
+    }
+
+    if( divided )
+    {
+      return ( remove_from_child( northwest, point, filter ) || remove_from_child( northeast, point, filter )
+               || remove_from_child( southwest, point, filter ) || remove_from_child( southeast, point, filter ) );
+    }
+    return false;
+  }
+
+  // Check whether a point at the location of the given point that is accepted by the filter is stored
+  bool
+  contains_point(
+    const Point& point,
+    // default: accept all points
+    const std::function<bool( const Point& )>& filter = []( const Point& ) { return true; } ) const
+  {
+    if( !boundary.contains( point ) )
+    {
+      return false;
+    }
+
+    if( std::any_of( points.begin(), points.end(), [&]( const Point& p ) { return p.x == point.x && p.y == point.y && filter( p ); } ) )
+    {
+      return true;
+    }
+
+    if( divided )
+    {
+      return ( northwest->contains_point( point, filter ) || northeast->contains_point( point, filter )
+               || southwest->contains_point( point, filter ) || southeast->contains_point( point, filter ) );
+    }
+    return false;
   }
 
   // Query all points within a range
@@ -133,6 +198,33 @@ public:
     }
   }
 
+  // Call visitor for every point within a range, without copying the points out
+  template<typename Visitor>
+  void
+  visit( const Boundary& range, Visitor&& visitor ) const
+  {
+    if( !boundary.intersects( range ) )
+    {
+      return;
+    }
+
+    for( const auto& point : points )
+    {
+      if( range.contains( point ) )
+      {
+        visitor( point );
+      }
+    }
+
+    if( divided )
+    {
+      northwest->visit( range, visitor );
+      northeast->visit( range, visitor );
+      southwest->visit( range, visitor );
+      southeast->visit( range, visitor );
+    }
+  }
+
   // Query all points within a given radius from a center point (circular range)
   template<typename QueryPoint>
   void
@@ -229,6 +321,42 @@ public:
     return nearest_point;
   }
 
+  // Call visitor( boundary, points, divided ) for every node in preorder:
+  // a node first, then its northwest, northeast, southwest and southeast subtrees
+  template<typename NodeVisitor>
+  void
+  visit_nodes( NodeVisitor&& visitor ) const
+  {
+    visitor( boundary, points, divided );
+    if( divided )
+    {
+      northwest->visit_nodes( visitor );
+      northeast->visit_nodes( visitor );
+      southwest->visit_nodes( visitor );
+      southeast->visit_nodes( visitor );
+    }
+  }
+
+  // Rebuild a tree from the preorder node sequence produced by visit_nodes, without re-inserting points.
+  // next_node() must return the NodeData of the next node in that order.
+  template<typename NodeSource>
+  static Quadtree
+  restore( NodeSource&& next_node, size_t capacity )
+  {
+    NodeData node = next_node();
+    Quadtree tree( node.boundary, capacity );
+    tree.points = std::move( node.points );
+    if( node.divided )
+    {
+      tree.northwest = std::make_shared<Quadtree<Point>>( restore( next_node, capacity ) );
+      tree.northeast = std::make_shared<Quadtree<Point>>( restore( next_node, capacity ) );
+      tree.southwest = std::make_shared<Quadtree<Point>>( restore( next_node, capacity ) );
+      tree.southeast = std::make_shared<Quadtree<Point>>( restore( next_node, capacity ) );
+      tree.divided   = true;
+    }
+    return tree;
+  }
+
   Boundary boundary;
   size_t   capacity = 10;
 
@@ -244,6 +372,30 @@ private:
   std::shared_ptr<Quadtree<Point>> southwest = nullptr;
   std::shared_ptr<Quadtree<Point>> southeast = nullptr;
 
+  // Copies of a tree share their children. A child is cloned before it is modified unless this tree is its
+  // only owner, so changing a copy never changes the tree it was copied from and unchanged subtrees stay shared.
+  static Quadtree<Point>*
+  mutable_child( std::shared_ptr<Quadtree<Point>>& child )
+  {
+    if( child.use_count() > 1 )
+    {
+      child = std::make_shared<Quadtree<Point>>( *child );
+    }
+    return child.get();
+  }
+
+  static bool
+  insert_into_child( std::shared_ptr<Quadtree<Point>>& child, const Point& point )
+  {
+    return child->boundary.contains( point ) && mutable_child( child )->insert( point );
+  }
+
+  static bool
+  remove_from_child( std::shared_ptr<Quadtree<Point>>& child, const Point& point, const std::function<bool( const Point& )>& filter )
+  {
+    return child->contains_point( point, filter ) && mutable_child( child )->remove( point, filter );
+  }
+
   // Subdivide the current node into four smaller nodes
   void
   subdivide()
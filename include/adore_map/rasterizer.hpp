@@ -0,0 +1,168 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "adore_map/lane.hpp"
+#include "adore_map/lane_polygons.hpp"
+#include "adore_map/lane_store.hpp"
+#include "adore_map/map_tiles.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+struct RasterConfig
+{
+  double                resolution        = 0.2;  // [m] cell size
+  double                tile_size         = 50.0; // [m] tile side length, rounded to whole cells
+  double                polygon_tolerance = 0.05; // [m] simplification of the lane outlines
+  std::vector<LaneType> drivable_types{ driving, parking, bus };
+};
+
+// Square block of raster cells, row major starting at (x_min, y_min)
+struct RasterTile
+{
+  static constexpr uint8_t NO_LANE = 0;
+
+  TileKey               key;
+  double                x_min = 0.0;
+  double                y_min = 0.0;
+  size_t                cells = 0;  // per side
+  std::vector<uint8_t>  lane_types; // LaneType + 1 per cell, NO_LANE outside all lanes
+  std::vector<uint16_t> lane_slots; // index + 1 into lane_ids, NO_LANE outside all lanes
+  std::vector<LaneID>   lane_ids;   // lanes overlapping the tile, sorted
+};
+
+// Tiled occupancy and lane id grids of the lane outlines.
+//
+// Point queries resolve the tile through a hash lookup and then read one cell, independent of map size.
+// A cell belongs to a lane if its center lies inside the lane outline; where lanes overlap, drivable lanes
+// win over others and lower lane ids over higher ones. Tiles are immutable and shared between copies, so
+// an update re-renders only the tiles the changed lanes touch(ed) and leaves all others in place.
+class MapRaster
+{
+public:
+
+  MapRaster( const RasterConfig& config = RasterConfig() );
+
+  // Renders all lanes on thread_count threads (0 = all cores)
+  static MapRaster build( const LaneStore& lanes, const RasterConfig& config = RasterConfig(), size_t thread_count = 0 );
+
+  // Re-renders the tiles covered by the old and new outlines of the given lanes. Lanes no longer in the
+  // store are removed from the raster.
+  void update( const LaneStore& lanes, const std::vector<LaneID>& changed_lane_ids, size_t thread_count = 0 );
+
+  bool
+  is_drivable( double x, double y ) const
+  {
+    return drivable[get_cell( x, y, &RasterTile::lane_types )];
+  }
+
+  // Lane covering the cell of a point, if any
+  std::optional<LaneID>
+  lane_at( double x, double y ) const
+  {
+    const RasterTile* tile = nullptr;
+    const auto        slot = get_cell( x, y, &RasterTile::lane_slots, &tile );
+    if( slot == RasterTile::NO_LANE )
+      return {};
+    return tile->lane_ids[slot - 1];
+  }
+
+  std::optional<LaneType>
+  lane_type_at( double x, double y ) const
+  {
+    const auto type = get_cell( x, y, &RasterTile::lane_types );
+    if( type == RasterTile::NO_LANE )
+      return {};
+    return static_cast<LaneType>( type - 1 );
+  }
+
+  TileKey
+  get_key( double x, double y ) const
+  {
+    return { static_cast<int64_t>( std::floor( x / tile_size ) ), static_cast<int64_t>( std::floor( y / tile_size ) ) };
+  }
+
+  // Tile at a key, nullptr if no lane overlaps it
+  std::shared_ptr<const RasterTile> get_tile( const TileKey& key ) const;
+
+  const RasterConfig&
+  get_config() const
+  {
+    return config;
+  }
+
+  double
+  get_tile_size() const
+  {
+    return tile_size;
+  }
+
+  size_t
+  size() const
+  {
+    return tiles.size();
+  }
+
+private:
+
+  using TileLanes = std::unordered_map<TileKey, std::vector<LaneID>, TileKeyHasher>;
+
+  template<typename Cell>
+  Cell
+  get_cell( double x, double y, std::vector<Cell> RasterTile::* layer, const RasterTile** found = nullptr ) const
+  {
+    auto it = tiles.find( get_key( x, y ) );
+    if( it == tiles.end() )
+      return RasterTile::NO_LANE;
+
+    const RasterTile& tile = *it->second;
+    const size_t      ix   = std::min( static_cast<size_t>( ( x - tile.x_min ) / config.resolution ), tile.cells - 1 );
+    const size_t      iy   = std::min( static_cast<size_t>( ( y - tile.y_min ) / config.resolution ), tile.cells - 1 );
+    if( found )
+      *found = &tile;
+    return ( tile.*layer )[iy * tile.cells + ix];
+  }
+
+  // Keys of all tiles overlapped by a box
+  std::vector<TileKey> get_keys( const LanePolygonIndex::Boundary& box ) const;
+
+  std::shared_ptr<const RasterTile> render_tile( const TileKey& key, const std::vector<LaneID>& lane_ids ) const;
+
+  void render_tiles( const std::vector<TileKey>& keys, size_t thread_count );
+
+  RasterConfig          config;
+  double                tile_size = 0.0;
+  size_t                cells     = 0;
+  std::array<bool, 256> drivable{}; // by cell value, LaneType + 1
+
+  std::unordered_map<TileKey, std::shared_ptr<const RasterTile>, TileKeyHasher> tiles;
+  TileLanes                                                                      tile_lanes;
+  std::unordered_map<LaneID, std::shared_ptr<const LanePolygon>>                 polygons;
+  std::unordered_map<LaneID, LaneType>                                           lane_types;
+};
+
+} // namespace map
+} // namespace adore
@@ -12,12 +12,19 @@
  ********************************************************************************/
 
 #pragma once
+#include <cstdint>
+
 #include <algorithm>
+#include <deque>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <memory>
 #include <optional>
 #include <queue>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "adore_map/lane.hpp"
@@ -27,8 +34,6 @@ namespace adore
 namespace map
 {
 
-using LaneID = size_t;
-
 enum ConnectionType
 {
   END_TO_START,
@@ -82,15 +87,81 @@ struct ConnectionHasher
   std::size_t
   operator()( const Connection& connection ) const
   {
-    // Use std::hash for size_t and double, combine the hashes
-    std::size_t from_hash = std::hash<size_t>()( connection.from_id );
-    std::size_t to_hash   = std::hash<size_t>()( connection.to_id );
+    // splitmix-style mixing of both ids, std::hash<size_t> is the identity on common standard libraries
+    uint64_t h  = static_cast<uint64_t>( connection.from_id ) * 0x9E3779B97F4A7C15ULL;
+    h          ^= static_cast<uint64_t>( connection.to_id ) + 0x7F4A7C159E3779B9ULL + ( h << 6 ) + ( h >> 2 );
+    return static_cast<std::size_t>( h );
+  }
+};
+
+// Direction of a search over the lane graph from one start lane
+enum SearchDirection
+{
+  FORWARD,  // lanes reachable from the start
+  BACKWARD, // lanes from which the start is reachable
+  BOTH      // connections usable both ways, as find_path with allow_reverse
+};
+
+// Lane found by RoadGraph::find_reachable
+struct ReachableLane
+{
+  LaneID lane_id  = 0;
+  double cost     = 0.0; // of the cheapest path between the start and the lane
+  LaneID previous = 0;   // next lane towards the start on that path, the start itself for the start
+};
+
+// Lanes within a cost budget of a start lane and the tree of cheapest paths to them
+struct ReachableSet
+{
+  SearchDirection                    direction = FORWARD;
+  std::vector<ReachableLane>         lanes; // in ascending cost, the start lane first
+  std::unordered_map<LaneID, size_t> index; // position of each lane in lanes
+
+  // Entry of a lane, nullptr if it was not reached
+  const ReachableLane*
+  find( LaneID lane_id ) const
+  {
+    auto it = index.find( lane_id );
+    return it == index.end() ? nullptr : &lanes[it->second];
+  }
 
-    // Combine the hashes
-    return from_hash ^ ( to_hash << 1 );
+  // Cheapest path between the start and a reached lane in driving direction, so ending at the start for
+  // BACKWARD searches. Empty if the lane was not reached.
+  std::deque<LaneID>
+  get_path( LaneID lane_id ) const
+  {
+    std::deque<LaneID> path;
+    for( const ReachableLane* lane = find( lane_id ); lane; lane = lane->previous == lane->lane_id ? nullptr : find( lane->previous ) )
+    {
+      if( direction == BACKWARD )
+        path.push_back( lane->lane_id );
+      else
+        path.push_front( lane->lane_id );
+    }
+    return path;
   }
 };
 
+// Options of RoadGraph::find_alternative_paths
+struct AlternativeRouteConfig
+{
+  size_t route_count     = 3;     // paths to return at most, the shortest included
+  double max_overlap     = 0.7;   // largest share of a path's cost on connections of the paths before it, 1 = plain Yen
+  double max_cost_factor = 1.5;   // paths may cost at most this times the shortest one
+  size_t candidate_limit = 50;    // loopless paths examined before giving up on finding route_count
+  bool   allow_reverse   = false; // as in find_path
+};
+
+class CompactRoadGraph;
+class ContractionHierarchy;
+class LandmarkIndex;
+class LaneStore;
+class WeightOverlay;
+class WeightOverlayHandle;
+struct ContractionConfig;
+struct LandmarkConfig;
+struct LanePositions;
+
 struct RoadGraph
 {
   RoadGraph() {};
@@ -98,13 +169,88 @@ struct RoadGraph
   std::unordered_map<LaneID, std::unordered_set<LaneID>> to_predecessors;
   std::unordered_set<Connection, ConnectionHasher>       all_connections;
 
+  // Changes whenever add_connection, remove_lane or set_weight change the graph, to a number no other graph
+  // in the process had before, so routes cached under it (see RouteCache) are valid for exactly this state.
+  // Copies share the version until one of them changes. Editing the adjacency maps directly does not count.
+  uint64_t version = 0;
+
+  // Optional frozen copy used by find_path, see build_compact(). Dropped by add_connection, remove_lane and
+  // set_weight; the searches then run on the hash maps until build_compact() is called again.
+  std::shared_ptr<const CompactRoadGraph> compact;
+
+  // Lane entry points from the last build_compact() with lanes, reused when the compact graph is rebuilt
+  // without them. Kept by edits, lanes connected later without a recorded position disable A*.
+  std::shared_ptr<const LanePositions> lane_positions;
+
+  // Optional contraction hierarchy used by find_path without a lane filter, see build_hierarchy(). Dropped
+  // by add_connection and remove_lane.
+  std::shared_ptr<const ContractionHierarchy> hierarchy;
+
+  // Optional landmark distances for the A* estimates of the compact graph, see build_landmarks(). Kept by
+  // remove_lane and by set_weight increases since they only make routes more expensive, dropped by
+  // add_connection and weight decreases.
+  std::shared_ptr<const LandmarkIndex> landmarks;
+
   // Adds a connection between two lanes
   bool add_connection( Connection connection );
 
-  // Finds the best path from one lane to another using Dijkstra
+  // Removes a lane together with all connections from and to it
+  void remove_lane( LaneID lane_id );
+
+  // Changes the weight of an existing connection, returns false if there is none
+  bool set_weight( LaneID from_id, LaneID to_id, double weight );
+
+  // Freezes the current connections into a compressed sparse row graph for faster searches. With the lanes
+  // the searches use A* on their positions, see CompactRoadGraph, and on the landmarks if there are any.
+  // Without lanes the positions recorded by an earlier build with lanes are used.
+  void build_compact( const LaneStore* lanes = nullptr );
+
+  // Computes landmark distances on the current connections and adds them to the compact graph, building
+  // one first if needed (with the recorded lane positions)
+  void build_landmarks( const LandmarkConfig& config );
+
+  // Preprocesses the current connections into a contraction hierarchy, building the compact graph first if
+  // needed (with the recorded lane positions). A previous hierarchy of this graph, kept from before the
+  // connections changed, lends its order.
+  void build_hierarchy( const ContractionConfig& config, const ContractionHierarchy* previous = nullptr );
+
+  // Finds the best path from one lane to another, following connections forwards only
   std::deque<LaneID> get_best_path( LaneID from, LaneID to ) const;
 
-  std::deque<LaneID> find_path( LaneID from, LaneID to, bool allow_reverse ) const;
+  // Shortest path over the lane graph, optionally restricted to lanes accepted by lane_filter. Runs on the
+  // contraction hierarchy if one was built for the same allow_reverse and there is no filter, else on the
+  // compact graph if one was built (A* if it knows the lane positions), Dijkstra on the hash maps otherwise.
+  std::deque<LaneID> find_path( LaneID from, LaneID to, bool allow_reverse,
+                                const std::function<bool( LaneID )>& lane_filter = nullptr ) const;
+
+  // Shortest path with the weights of an overlay instead of the connection weights, on the compact graph
+  // the overlay was made for, see WeightOverlay. Throws std::runtime_error if the overlay was made for
+  // another version of this graph. The searches below take an overlay the same way.
+  std::deque<LaneID> find_path( LaneID from, LaneID to, bool allow_reverse, const WeightOverlay& overlay,
+                                const std::function<bool( LaneID )>& lane_filter = nullptr ) const;
+
+  // Same with the overlay currently published by a handle, the connection weights if there is none
+  std::deque<LaneID> find_path( LaneID from, LaneID to, bool allow_reverse, const WeightOverlayHandle& overlays,
+                                const std::function<bool( LaneID )>& lane_filter = nullptr ) const;
+
+  // Same result as find_path, searching forward from the start and backward from the goal at once on the
+  // compact graph. Without one it is find_path on the hash maps.
+  std::deque<LaneID> find_path_bidirectional( LaneID from, LaneID to, bool allow_reverse,
+                                              const std::function<bool( LaneID )>& lane_filter = nullptr,
+                                              const WeightOverlay*                 overlay     = nullptr ) const;
+
+  // All lanes whose cheapest path from the start (to it for BACKWARD) costs at most max_cost, with that
+  // cost and the tree of those paths, in one Dijkstra pass that stops at the budget, or once all targets
+  // are reached if any are given. Without lane changes PARALLEL connections are not followed. Runs on the
+  // compact graph if one was built, on the hash maps otherwise.
+  ReachableSet find_reachable( LaneID from, double max_cost, SearchDirection direction = FORWARD, bool allow_lane_changes = true,
+                               std::span<const LaneID> targets = {}, const WeightOverlay* overlay = nullptr ) const;
+
+  // Shortest path and meaningfully different alternatives in ascending cost, by Yen's k shortest loopless
+  // paths filtered by overlap and cost. Empty if there is no path. Runs on the compact graph, throws
+  // std::runtime_error if build_compact() was not called.
+  std::vector<std::deque<LaneID>> find_alternative_paths( LaneID from, LaneID to, const AlternativeRouteConfig& config = {},
+                                                          const WeightOverlay* overlay = nullptr ) const;
 
   // Helper function to reconstruct the path from `from` to `to`
   std::deque<LaneID> reconstruct_path( LaneID from, LaneID to, const std::unordered_map<LaneID, LaneID>& previous_roads ) const;
@@ -112,17 +258,26 @@ struct RoadGraph
   // Helper function to find the connection between two lanes
   std::optional<Connection> find_connection( LaneID from_id, LaneID to_id ) const;
 
+  // Graph of all connections between the given lanes, built from their adjacency lists only
   RoadGraph
   create_subgraph( const std::unordered_set<LaneID>& valid_lane_ids ) const
   {
     RoadGraph subgraph;
 
-    for( const auto& connection : this->all_connections )
+    for( const auto& from_id : valid_lane_ids )
     {
-      if( valid_lane_ids.find( connection.from_id ) != valid_lane_ids.end()
-          && valid_lane_ids.find( connection.to_id ) != valid_lane_ids.end() )
+      auto successors_it = to_successors.find( from_id );
+      if( successors_it == to_successors.end() )
+        continue;
+
+      for( const auto& to_id : successors_it->second )
       {
-        subgraph.add_connection( connection );
+        if( valid_lane_ids.find( to_id ) == valid_lane_ids.end() )
+          continue;
+
+        auto connection = find_connection( from_id, to_id );
+        if( connection )
+          subgraph.add_connection( *connection );
       }
     }
 
@@ -22,6 +22,7 @@
 #include <cmath>  //new 
 #include <limits> //new
 
+#include "adore_map/frenet.hpp"
 #include "adore_map/lane.hpp"
 #include "adore_map/map.hpp"
 #include "adore_map/quadtree.hpp"
@@ -50,13 +51,13 @@ struct Route
   Route() {};
   std::unordered_map<size_t, std::shared_ptr<RouteSection>> lane_to_sections;
   std::deque<std::shared_ptr<RouteSection>>                 sections;
-  std::shared_ptr<Map>                                      map;
+  std::shared_ptr<const Map>                                map;
   adore::math::Point2d                                      start;
   adore::math::Point2d                                      destination;
   std::map<double, MapPoint>                                reference_line;
 
   double               get_length() const;
-  void                 add_route_section( Border& points, const MapPoint& start_point, const MapPoint& end_point, bool reverse );
+  void                 add_route_section( const Border& points, const MapPoint& start_point, const MapPoint& end_point, bool reverse );
   std::deque<MapPoint> get_shortened_route( double start_s, double desired_length ) const;
   MapPoint             get_map_point_at_s( double distance ) const;
   math::Pose2d         get_pose_at_s( double distance ) const;
@@ -64,11 +65,19 @@ struct Route
   void                 initialize_reference_line();
 
   template<typename StartPoint, typename EndPoint>
-  Route( const StartPoint& start_point, const EndPoint& end, const std::shared_ptr<Map>& reference_map );
+  Route( const StartPoint& start_point, const EndPoint& end, const std::shared_ptr<const Map>& reference_map );
 
   template<typename State>
   double get_s( const State& state ) const;
 
+  // Exact projection onto the route: s is the route distance, d is positive left of the driving direction
+  // and lane_id is the route lane the point was projected onto. Empty without map or route lanes.
+  template<typename Point>
+  std::optional<FrenetCoordinate> to_frenet( const Point& point ) const;
+
+  // Pose at route distance s shifted by d to the left of the driving direction, inverse of to_frenet
+  math::Pose2d from_frenet( double s, double d ) const;
+
   template<typename TPoint>
   TPoint interpolate_at_s( double distance ) const;
 
@@ -77,7 +86,7 @@ struct Route
 };
 
 template<typename StartPoint, typename EndPoint>
-Route::Route( const StartPoint& start_point, const EndPoint& end, const std::shared_ptr<Map>& reference_map )
+Route::Route( const StartPoint& start_point, const EndPoint& end, const std::shared_ptr<const Map>& reference_map )
 {
   start.x       = start_point.x;
   start.y       = start_point.y;
@@ -104,7 +113,7 @@ Route::Route( const StartPoint& start_point, const EndPoint& end, const std::sha
     // Iterate over the route and process each lane
     for( size_t i = 0; i < lane_id_route.size(); ++i )
     {
-      auto lane = map->lanes.at( lane_id_route[i] );
+      const auto& lane = map->lanes.at( lane_id_route[i] );
       add_route_section( lane->borders.center, *nearest_start_point, *nearest_end_point, lane->left_of_reference );
     }
 
@@ -146,6 +155,39 @@ Route::get_s( const State& state ) const
   return refine_s_with_arc( state, route_distance );
 }
 
+template<typename Point>
+std::optional<FrenetCoordinate>
+Route::to_frenet( const Point& point ) const
+{
+  if( !map )
+    return {};
+
+  double min_dist = std::numeric_limits<double>::max();
+  auto   nearest  = map->quadtree.get_nearest_point( point, min_dist, [&]( const MapPoint& p ) {
+    return ( lane_to_sections.find( p.parent_id ) != lane_to_sections.end() );
+  } );
+  if( !nearest )
+    return {};
+
+  auto lane_it = map->lanes.find( nearest->parent_id );
+  if( lane_it == map->lanes.end() || !lane_it->second )
+    return {};
+
+  // Project onto the lane, then map lane s and side onto the driving direction of the section
+  const auto& section = lane_to_sections.at( nearest->parent_id );
+  auto        frenet  = project_onto_lane( *lane_it->second, point.x, point.y, nearest->s );
+  if( section->start_s <= section->end_s )
+  {
+    frenet.s = section->route_s + ( frenet.s - section->start_s );
+  }
+  else
+  {
+    frenet.s = section->route_s + ( section->start_s - frenet.s );
+    frenet.d = -frenet.d;
+  }
+  return frenet;
+}
+
 template<typename TPoint>
 TPoint
 Route::interpolate_at_s( double distance ) const
@@ -0,0 +1,117 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+
+#pragma once
+#include <cstdint>
+
+#include <atomic>
+#include <deque>
+#include <functional>
+
+#include "adore_map/road_graph.hpp"
+#include "caches/lru_cache_policy.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Route query as cached by RouteCache
+struct RouteKey
+{
+  LaneID   from          = 0;
+  LaneID   to            = 0;
+  bool     allow_reverse = false;
+  uint64_t version       = 0; // RoadGraph::version the route was computed on
+
+  bool
+  operator==( const RouteKey& other ) const
+  {
+    return from == other.from && to == other.to && allow_reverse == other.allow_reverse && version == other.version;
+  }
+};
+
+} // namespace map
+} // namespace adore
+
+template<>
+struct std::hash<adore::map::RouteKey>
+{
+  size_t
+  operator()( const adore::map::RouteKey& key ) const
+  {
+    // Same mixing as ConnectionHasher, then the version and direction
+    uint64_t h  = static_cast<uint64_t>( key.from ) * 0x9E3779B97F4A7C15ULL;
+    h          ^= static_cast<uint64_t>( key.to ) + 0x7F4A7C159E3779B9ULL + ( h << 6 ) + ( h >> 2 );
+    h          ^= ( key.version * 2 + key.allow_reverse ) + 0x7F4A7C159E3779B9ULL + ( h << 6 ) + ( h >> 2 );
+    return static_cast<size_t>( h );
+  }
+};
+
+namespace adore
+{
+namespace map
+{
+
+struct RouteCacheStats
+{
+  uint64_t hits   = 0;
+  uint64_t misses = 0;
+  size_t   size   = 0; // routes currently cached
+
+  double
+  hit_rate() const
+  {
+    return hits + misses == 0 ? 0.0 : static_cast<double>( hits ) / static_cast<double>( hits + misses );
+  }
+};
+
+// Least recently used cache of RoadGraph::find_path results.
+//
+// Routes are keyed by start lane, goal lane, allow_reverse and the version of the graph. Every change through
+// add_connection, remove_lane or set_weight gives the graph a new version, so routes of an older state can no
+// longer be hit and age out of the cache. Copies of a graph share cached routes until one of them changes.
+// Searches with a lane filter are not cached. Safe to use from several threads at once.
+class RouteCache
+{
+public:
+
+  explicit RouteCache( size_t capacity = 1024 );
+
+  // Same result as graph.find_path, searched only if the route is not cached for this version of the graph
+  std::deque<LaneID> find_path( const RoadGraph& graph, LaneID from, LaneID to, bool allow_reverse );
+
+  // Same result as graph.get_best_path
+  std::deque<LaneID>
+  get_best_path( const RoadGraph& graph, LaneID from, LaneID to )
+  {
+    return find_path( graph, from, to, false );
+  }
+
+  RouteCacheStats get_stats() const;
+
+  // Drops all routes and resets the statistics
+  void clear();
+
+private:
+
+  using Cache = caches::fixed_sized_cache<RouteKey, std::deque<LaneID>, caches::LRUCachePolicy>;
+
+  Cache                 cache;
+  std::atomic<uint64_t> hits   = 0;
+  std::atomic<uint64_t> misses = 0;
+};
+
+} // namespace map
+} // namespace adore
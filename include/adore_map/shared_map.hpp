@@ -0,0 +1,55 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <string>
+
+#include "adore_map/compiled_map.hpp"
+#include "adore_map/map.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Publication of a map to other processes on the same host through POSIX shared memory.
+//
+// The map is stored in the compiled map format, which contains no pointers, so every process can
+// map the segment read-only at its own address and query it in place through CompiledMap. Only one
+// copy of the map exists in memory regardless of the number of attached processes.
+//
+// A successful attach never sees a partially written map: publish writes the magic of the segment
+// last and attach checks it. Republishing is not atomic for new readers though. publish removes the
+// old name before the new segment is complete, so an attach racing with publish fails, either
+// because the segment does not exist yet or because its magic is not written. Readers that start
+// alongside a publisher should retry attach until it succeeds.
+class SharedMap
+{
+public:
+
+  // Publishes a map under a segment name (e.g. "/adore_map"), replacing an earlier segment of that name.
+  // Processes attached to the earlier segment keep their mapping until they detach.
+  // Throws std::runtime_error if the segment cannot be created.
+  static void publish( const Map& map, const std::string& segment_name );
+
+  // Attaches read-only to a published segment without copying it. Throws std::runtime_error if the
+  // segment does not exist or its publication has not completed yet; both are transient while a
+  // publish is in progress, so the call can be retried.
+  static CompiledMap attach( const std::string& segment_name );
+
+  // Removes the segment name, returns false if no such segment exists. Attached processes are not affected.
+  static bool remove( const std::string& segment_name );
+};
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,103 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#pragma once
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "adore_map/map.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Lanes that entered and left the window during one SubmapTracker update
+struct SubmapDelta
+{
+  std::vector<LaneID> added_lane_ids;
+  std::vector<LaneID> removed_lane_ids;
+
+  bool
+  empty() const
+  {
+    return added_lane_ids.empty() && removed_lane_ids.empty();
+  }
+};
+
+// Keeps a submap of a parent map around a moving center up to date.
+//
+// Instead of rebuilding the submap every cycle, each update determines which lanes entered and
+// which left the window and patches the submap's lanes, roads, quadtree and lane graph for those
+// lanes only. Lanes are shared with the parent map, not copied. The returned delta lets consumers
+// of the submap update their own state incrementally as well.
+class SubmapTracker
+{
+public:
+
+  using Boundary = Quadtree<MapPoint>::Boundary;
+
+  SubmapTracker( const std::shared_ptr<const Map>& parent_map, double width, double height );
+
+  // Moves the window to a new center and returns the lanes that entered and left it
+  template<typename CenterPoint>
+  SubmapDelta
+  update( const CenterPoint& center )
+  {
+    Boundary window;
+    window.x_min = center.x - width / 2.0;
+    window.x_max = center.x + width / 2.0;
+    window.y_min = center.y - height / 2.0;
+    window.y_max = center.y + height / 2.0;
+    return update_window( window );
+  }
+
+  // Moves the window to the given boundary and returns the lanes that entered and left it
+  SubmapDelta update_window( const Boundary& window );
+
+  // Removes all lanes from the submap, the next update starts from scratch
+  void reset();
+
+  const Map&
+  get_submap() const
+  {
+    return submap;
+  }
+
+  const Boundary&
+  get_window() const
+  {
+    return window;
+  }
+
+  bool
+  contains_lane( LaneID lane_id ) const
+  {
+    return submap.lanes.count( lane_id ) > 0;
+  }
+
+private:
+
+  std::shared_ptr<const Map> parent;
+  double                     width;
+  double                     height;
+  Boundary                   window{ 0.0, 0.0, 0.0, 0.0 };
+  Map                        submap;
+
+  void add_lane( LaneID lane_id );
+  void remove_lane( LaneID lane_id );
+};
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,186 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "adore_map/compact_road_graph.hpp"
+#include "adore_map/lane_store.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+// Runtime connection weights on top of a frozen lane graph: closures, congestion multipliers and lanes
+// a vehicle class may not use.
+//
+// The overlay holds weights for every edge of its CompactRoadGraph, initially the graph's own, so changing
+// it touches neither RoadGraph nor the compact graph, and routing on it costs no more than on the graph
+// itself. Each connection has one weight for following it and one for driving it backwards (allow_reverse),
+// so a closed lane can be closed for entering from both ends while routes can still leave it. Closed
+// connections get an infinite weight. As long as no weight is below the graph's, A* keeps using the lane
+// positions and landmarks of the graph.
+//
+// An overlay belongs to one version of the lane graph (RoadGraph::version). Routing with it on any other
+// version throws, since it would bring back the weights the graph had when the overlay was made.
+//
+// An overlay is built or modified by one thread and then published through a WeightOverlayHandle, after
+// which it must not change.
+class WeightOverlay
+{
+public:
+
+  WeightOverlay() {};
+
+  explicit WeightOverlay( std::shared_ptr<const CompactRoadGraph> graph );
+
+  // The connection can no longer be used, returns false if the graph has no such connection
+  bool close_connection( LaneID from_id, LaneID to_id );
+
+  // No route may enter the lane anymore, neither over its incoming connections nor backwards over its
+  // outgoing ones. Routes starting on it can still leave. Returns false if the lane is not in the graph.
+  bool close_lane( LaneID lane_id );
+
+  // Sets the cost of driving along a lane to factor times the graph's, i.e. the weights of its connections
+  // other than lane changes. Closed connections stay closed. Returns false if the lane is not in the graph,
+  // throws std::invalid_argument if the factor is negative, infinite or NaN.
+  bool scale_lane( LaneID lane_id, double factor );
+
+  // Closes all lanes of the given types, e.g. bus and tram lanes for cars
+  void restrict_lane_types( const LaneStore& lanes, const std::vector<LaneType>& types );
+
+  // Shortest path with the overlay weights, same semantics as RoadGraph::find_path
+  std::deque<LaneID> find_path( LaneID from, LaneID to, bool allow_reverse,
+                                const std::function<bool( LaneID )>& lane_filter = nullptr ) const;
+
+  const std::shared_ptr<const CompactRoadGraph>&
+  get_graph() const
+  {
+    return graph;
+  }
+
+  // Whether this overlay can stand in for the weights of the given graph: its own, or one built from the
+  // same version of the lane graph
+  bool
+  matches( const CompactRoadGraph& other ) const
+  {
+    return graph
+        && ( graph.get() == &other
+             || ( graph->get_version() != 0 && other.get_version() == graph->get_version() && other.node_count() == graph->node_count()
+                  && other.edge_count() == graph->edge_count() ) );
+  }
+
+  // Weights of the successor (or predecessor) edges of a node, for following their connections (along) or
+  // for driving them backwards
+  const double*
+  get_weights( NodeIndex node, bool successors, bool along ) const
+  {
+    if( successors )
+      return ( along ? along_forward : against_forward ).data() + graph->forward_offsets[node];
+    return ( along ? along_reverse : against_reverse ).data() + graph->reverse_offsets[node];
+  }
+
+  // True if some weight is below the graph's, so distance estimates of the graph no longer hold
+  bool
+  lowers_weights() const
+  {
+    return lowered;
+  }
+
+private:
+
+  friend class CompactRoadGraph;
+
+  // Sets the weight of following (along) or driving backwards a connection, given by its forward edge, in
+  // both copies of the edge
+  void set_edge_weight( NodeIndex from, uint32_t forward_index, bool along, double weight );
+
+  std::shared_ptr<const CompactRoadGraph> graph;
+  std::vector<double>                     along_forward;   // by forward edge of the graph
+  std::vector<double>                     along_reverse;   // by reverse edge of the graph
+  std::vector<double>                     against_forward; // by forward edge, driving the connection backwards
+  std::vector<double>                     against_reverse; // by reverse edge, driving the connection backwards
+  bool                                    lowered = false;
+};
+
+// Publishes weight overlays to concurrent routers, like MapHandle does for maps. Routers take the current
+// overlay and keep using it for as long as they like, publishing a new one never blocks them.
+class WeightOverlayHandle
+{
+public:
+
+  WeightOverlayHandle() {};
+
+  explicit WeightOverlayHandle( std::shared_ptr<const WeightOverlay> initial_overlay ) :
+    current( std::move( initial_overlay ) )
+  {}
+
+  WeightOverlayHandle( const WeightOverlayHandle& )            = delete;
+  WeightOverlayHandle& operator=( const WeightOverlayHandle& ) = delete;
+
+  // Current overlay, nullptr if none was published yet. Safe to call from any thread.
+  std::shared_ptr<const WeightOverlay>
+  get() const
+  {
+    return current.load( std::memory_order_acquire );
+  }
+
+  uint64_t
+  get_version() const
+  {
+    return version.load( std::memory_order_acquire );
+  }
+
+  // Replaces the overlay, returns the new version number
+  uint64_t
+  publish( std::shared_ptr<const WeightOverlay> next_overlay )
+  {
+    std::lock_guard<std::mutex> lock( writer_mutex );
+    current.store( std::move( next_overlay ), std::memory_order_release );
+    return ++version;
+  }
+
+  // Applies updater( WeightOverlay& ) to a copy of the current overlay and publishes the result. Writers
+  // are serialized. Throws std::logic_error if no overlay was published yet.
+  template<typename Updater>
+  uint64_t
+  update( Updater&& updater )
+  {
+    std::lock_guard<std::mutex> lock( writer_mutex );
+    const auto                  previous = current.load( std::memory_order_acquire );
+    if( !previous )
+      throw std::logic_error( "WeightOverlayHandle: update needs a published overlay" );
+    auto next_overlay = std::make_shared<WeightOverlay>( *previous );
+    updater( *next_overlay );
+    current.store( std::move( next_overlay ), std::memory_order_release );
+    return ++version;
+  }
+
+private:
+
+  std::atomic<std::shared_ptr<const WeightOverlay>> current;
+  std::atomic<uint64_t>                             version = 0;
+  std::mutex                                        writer_mutex;
+};
+
+} // namespace map
+} // namespace adore
@@ -159,7 +159,7 @@ Border::initialize_spline()
 }
 
 double
-Border::find_nearest_s( const MapPoint& point )
+Border::find_nearest_s( const MapPoint& point ) const
 {
   if( !spline )
   {
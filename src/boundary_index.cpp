@@ -0,0 +1,289 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/boundary_index.hpp"
+
+#include <cmath>
+
+#include <algorithm>
+#include <array>
+
+#include "adore_map/parallel.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+namespace
+{
+
+const std::vector<MapPoint>&
+border_points( const Border& border )
+{
+  return border.interpolated_points.empty() ? border.points : border.interpolated_points;
+}
+
+BoundaryIndex::Boundary
+segment_box( const BoundarySegment& segment )
+{
+  return { std::min( segment.start.x, segment.end.x ), std::max( segment.start.x, segment.end.x ),
+           std::min( segment.start.y, segment.end.y ), std::max( segment.start.y, segment.end.y ) };
+}
+
+// Fraction along the segment of the point closest to (x, y)
+double
+closest_fraction( const BoundarySegment& segment, double x, double y )
+{
+  const double dx        = segment.end.x - segment.start.x;
+  const double dy        = segment.end.y - segment.start.y;
+  const double length_sq = dx * dx + dy * dy;
+  if( length_sq <= 0.0 )
+    return 0.0;
+  return std::clamp( ( ( x - segment.start.x ) * dx + ( y - segment.start.y ) * dy ) / length_sq, 0.0, 1.0 );
+}
+
+BoundaryHit
+make_hit( const BoundarySegment& segment, double t, double distance )
+{
+  BoundaryHit hit;
+  hit.lane_id  = segment.lane_id;
+  hit.side     = segment.side;
+  hit.type     = segment.type;
+  hit.x        = segment.start.x + t * ( segment.end.x - segment.start.x );
+  hit.y        = segment.start.y + t * ( segment.end.y - segment.start.y );
+  hit.s        = segment.start_s + t * ( segment.end_s - segment.start_s );
+  hit.distance = distance;
+  return hit;
+}
+
+} // namespace
+
+BoundaryIndex
+BoundaryIndex::build( const LaneStore& lanes, const BoundaryConfig& config, size_t thread_count, const LanePolygonIndex* outlines )
+{
+  std::optional<LanePolygonIndex> built_outlines;
+  if( !outlines )
+    outlines = &built_outlines.emplace( LanePolygonIndex::build( lanes, 0.05, thread_count ) );
+
+  std::array<bool, bus + 1> drivable{};
+  for( const auto type : config.drivable_types )
+    drivable[type] = true;
+
+  std::vector<const Lane*> lane_list;
+  for( const auto& [lane_id, lane] : lanes )
+  {
+    if( lane )
+      lane_list.push_back( lane.get() );
+  }
+  std::sort( lane_list.begin(), lane_list.end(), []( const Lane* a, const Lane* b ) { return a->id < b->id; } );
+
+  std::vector<std::vector<BoundarySegment>> lane_segments( lane_list.size() );
+  parallel_for( lane_list.size(), thread_count, [&]( size_t i ) {
+    const Lane&        lane = *lane_list[i];
+    const LanePolygon* own  = outlines->find( lane.id );
+
+    for( const auto side : { inner_border, outer_border } )
+    {
+      const auto& points = border_points( side == inner_border ? lane.borders.inner : lane.borders.outer );
+      for( size_t k = 0; k + 1 < points.size(); ++k )
+      {
+        BoundarySegment segment;
+        segment.lane_id = lane.id;
+        segment.side    = side;
+        segment.start   = { points[k].x, points[k].y };
+        segment.end     = { points[k + 1].x, points[k + 1].y };
+        segment.start_s = points[k].s;
+        segment.end_s   = points[k + 1].s;
+
+        const double length = std::hypot( segment.end.x - segment.start.x, segment.end.y - segment.start.y );
+        if( length <= 0.0 )
+          continue;
+
+        // Probe the side of the segment that the lane itself does not cover
+        const double mid_x   = 0.5 * ( segment.start.x + segment.end.x );
+        const double mid_y   = 0.5 * ( segment.start.y + segment.end.y );
+        const double probe_x = -( segment.end.y - segment.start.y ) / length * config.probe_distance;
+        const double probe_y = ( segment.end.x - segment.start.x ) / length * config.probe_distance;
+        const double sign    = own && own->contains( mid_x + probe_x, mid_y + probe_y ) ? -1.0 : 1.0;
+
+        segment.type = road_edge;
+        for( const auto other_id : outlines->lanes_containing( mid_x + sign * probe_x, mid_y + sign * probe_y ) )
+        {
+          if( other_id != lane.id && drivable[lanes.at( other_id )->type] )
+          {
+            segment.type = lane_divider;
+            break;
+          }
+        }
+        lane_segments[i].push_back( segment );
+      }
+    }
+  } );
+
+  BoundaryIndex index;
+  for( auto& segments : lane_segments )
+    index.segments.insert( index.segments.end(), segments.begin(), segments.end() );
+
+  if( !index.segments.empty() )
+    index.build_node( 0, index.segments.size() );
+  return index;
+}
+
+uint32_t
+BoundaryIndex::build_node( size_t begin, size_t end )
+{
+  const auto node_index = static_cast<uint32_t>( nodes.size() );
+  nodes.emplace_back();
+
+  const double max = std::numeric_limits<double>::max();
+  Boundary     box{ max, -max, max, -max };
+  for( size_t i = begin; i < end; ++i )
+  {
+    const Boundary segment = segment_box( segments[i] );
+    box.x_min              = std::min( box.x_min, segment.x_min );
+    box.x_max              = std::max( box.x_max, segment.x_max );
+    box.y_min              = std::min( box.y_min, segment.y_min );
+    box.y_max              = std::max( box.y_max, segment.y_max );
+  }
+  nodes[node_index].box = box;
+
+  if( end - begin <= LEAF_SIZE )
+  {
+    nodes[node_index].leaf  = true;
+    nodes[node_index].left  = static_cast<uint32_t>( begin );
+    nodes[node_index].right = static_cast<uint32_t>( end - begin );
+    return node_index;
+  }
+
+  // Split at the median segment center along the longer side
+  const bool   split_x = box.x_max - box.x_min >= box.y_max - box.y_min;
+  const size_t middle  = begin + ( end - begin ) / 2;
+  std::nth_element( segments.begin() + begin, segments.begin() + middle, segments.begin() + end,
+                    [split_x]( const BoundarySegment& a, const BoundarySegment& b ) {
+                      return split_x ? a.start.x + a.end.x < b.start.x + b.end.x : a.start.y + a.end.y < b.start.y + b.end.y;
+                    } );
+
+  const uint32_t left     = build_node( begin, middle );
+  const uint32_t right    = build_node( middle, end );
+  nodes[node_index].left  = left;
+  nodes[node_index].right = right;
+  return node_index;
+}
+
+std::optional<BoundaryHit>
+BoundaryIndex::nearest( double x, double y, double max_distance, std::optional<BoundaryType> type ) const
+{
+  std::optional<BoundaryHit> best;
+  if( nodes.empty() )
+    return best;
+
+  const adore::math::Point2d query{ x, y };
+  double                     best_distance = max_distance;
+
+  // Depth first, nearer child first, skipping nodes that cannot beat the best hit so far
+  std::vector<uint32_t> stack{ 0 };
+  while( !stack.empty() )
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+    if( node.box.distance_to_point( query ) > best_distance )
+      continue;
+
+    if( !node.leaf )
+    {
+      const bool left_first = nodes[node.left].box.distance_to_point( query ) <= nodes[node.right].box.distance_to_point( query );
+      stack.push_back( left_first ? node.right : node.left );
+      stack.push_back( left_first ? node.left : node.right );
+      continue;
+    }
+
+    for( uint32_t i = node.left; i < node.left + node.right; ++i )
+    {
+      const auto& segment = segments[i];
+      if( type && segment.type != *type )
+        continue;
+
+      const double t        = closest_fraction( segment, x, y );
+      const double distance = std::hypot( segment.start.x + t * ( segment.end.x - segment.start.x ) - x,
+                                          segment.start.y + t * ( segment.end.y - segment.start.y ) - y );
+      if( distance <= best_distance )
+      {
+        best_distance = distance;
+        best          = make_hit( segment, t, distance );
+      }
+    }
+  }
+  return best;
+}
+
+std::vector<BoundaryHit>
+BoundaryIndex::crossings( double start_x, double start_y, double end_x, double end_y ) const
+{
+  std::vector<BoundaryHit> hits;
+  if( nodes.empty() )
+    return hits;
+
+  const Boundary window{ std::min( start_x, end_x ), std::max( start_x, end_x ), std::min( start_y, end_y ), std::max( start_y, end_y ) };
+  const double   dx     = end_x - start_x;
+  const double   dy     = end_y - start_y;
+  const double   length = std::hypot( dx, dy );
+
+  std::vector<uint32_t> stack{ 0 };
+  while( !stack.empty() )
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+    if( !node.box.intersects( window ) )
+      continue;
+
+    if( !node.leaf )
+    {
+      stack.push_back( node.left );
+      stack.push_back( node.right );
+      continue;
+    }
+
+    for( uint32_t i = node.left; i < node.left + node.right; ++i )
+    {
+      const auto& segment = segments[i];
+      if( !segment_box( segment ).intersects( window ) )
+        continue;
+
+      // Solve start + u * (end - start) = segment.start + t * (segment.end - segment.start)
+      const double ex    = segment.end.x - segment.start.x;
+      const double ey    = segment.end.y - segment.start.y;
+      const double denom = dx * ey - dy * ex;
+      if( denom == 0.0 )
+        continue; // parallel, touching along a line does not cross
+
+      const double wx = segment.start.x - start_x;
+      const double wy = segment.start.y - start_y;
+      const double u  = ( wx * ey - wy * ex ) / denom;
+      const double t  = ( wx * dy - wy * dx ) / denom;
+      // Half open along the border so a crossing at a shared vertex counts once
+      if( u < 0.0 || u > 1.0 || t < 0.0 || t >= 1.0 )
+        continue;
+
+      hits.push_back( make_hit( segment, t, u * length ) );
+    }
+  }
+
+  std::sort( hits.begin(), hits.end(), []( const BoundaryHit& a, const BoundaryHit& b ) {
+    return a.distance < b.distance || ( a.distance == b.distance && a.lane_id < b.lane_id );
+  } );
+  return hits;
+}
+
+} // namespace map
+} // namespace adore
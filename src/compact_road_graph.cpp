@@ -0,0 +1,742 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/compact_road_graph.hpp"
+
+#include <cmath>
+
+#include <queue>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "adore_map/weight_overlay.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+namespace
+{
+
+// Per node search labels, reset in constant time by bumping the generation
+struct SearchLabels
+{
+  std::vector<double>    cost;
+  std::vector<double>    estimate; // of the remaining cost, valid once reached
+  std::vector<NodeIndex> previous;
+  std::vector<uint32_t>  reached; // generation in which the node got a cost
+  std::vector<uint32_t>  settled; // generation in which the node was settled
+  uint32_t               generation = 0;
+
+  void
+  reset( size_t node_count )
+  {
+    if( cost.size() != node_count || generation == std::numeric_limits<uint32_t>::max() )
+    {
+      cost.assign( node_count, 0.0 );
+      estimate.assign( node_count, 0.0 );
+      previous.assign( node_count, NO_NODE );
+      reached.assign( node_count, 0 );
+      settled.assign( node_count, 0 );
+      generation = 0;
+    }
+    ++generation;
+  }
+
+  bool
+  improves( NodeIndex node, double new_cost ) const
+  {
+    return reached[node] != generation || new_cost < cost[node];
+  }
+};
+
+// Labels are reused by all searches on the same thread, slot 1 holds the backward search of a bidirectional one
+SearchLabels&
+get_labels( size_t node_count, size_t slot = 0 )
+{
+  thread_local SearchLabels labels[2];
+  labels[slot].reset( node_count );
+  return labels[slot];
+}
+
+// Throws if an overlay was made for another graph
+void
+check_overlay( const WeightOverlay* overlay, const CompactRoadGraph& graph )
+{
+  if( overlay && !overlay->matches( graph ) )
+    throw std::runtime_error( "Weight overlay was made for a different lane graph" );
+}
+
+// Overlay weights of the successor or predecessor edges of a node, nullptr for the graph's own. along is
+// true for following the connections, false for driving them backwards.
+const double*
+get_weights( const WeightOverlay* overlay, NodeIndex node, bool successors, bool along )
+{
+  return overlay ? overlay->get_weights( node, successors, along ) : nullptr;
+}
+
+} // namespace
+
+CompactRoadGraph
+CompactRoadGraph::build( const RoadGraph& graph, const LaneStore* lanes )
+{
+  CompactRoadGraph compact;
+  compact.version = graph.version;
+
+  for( const auto& connection : graph.all_connections )
+  {
+    compact.lane_ids.push_back( connection.from_id );
+    compact.lane_ids.push_back( connection.to_id );
+  }
+  std::sort( compact.lane_ids.begin(), compact.lane_ids.end() );
+  compact.lane_ids.erase( std::unique( compact.lane_ids.begin(), compact.lane_ids.end() ), compact.lane_ids.end() );
+
+  // Sorted connections give every node a deterministic edge order
+  std::vector<Connection> connections( graph.all_connections.begin(), graph.all_connections.end() );
+  std::sort( connections.begin(), connections.end(), []( const Connection& a, const Connection& b ) {
+    return a.from_id < b.from_id || ( a.from_id == b.from_id && a.to_id < b.to_id );
+  } );
+
+  const size_t node_count = compact.lane_ids.size();
+  compact.forward_offsets.assign( node_count + 1, 0 );
+  compact.reverse_offsets.assign( node_count + 1, 0 );
+  for( const auto& connection : connections )
+  {
+    ++compact.forward_offsets[compact.find_node( connection.from_id ) + 1];
+    ++compact.reverse_offsets[compact.find_node( connection.to_id ) + 1];
+  }
+  for( size_t node = 0; node < node_count; ++node )
+  {
+    compact.forward_offsets[node + 1] += compact.forward_offsets[node];
+    compact.reverse_offsets[node + 1] += compact.reverse_offsets[node];
+  }
+
+  compact.forward_edges.resize( connections.size() );
+  compact.reverse_edges.resize( connections.size() );
+  std::vector<uint32_t> forward_fill( compact.forward_offsets.begin(), compact.forward_offsets.end() - 1 );
+  std::vector<uint32_t> reverse_fill( compact.reverse_offsets.begin(), compact.reverse_offsets.end() - 1 );
+  for( const auto& connection : connections )
+  {
+    const NodeIndex from = compact.find_node( connection.from_id );
+    const NodeIndex to   = compact.find_node( connection.to_id );
+
+    compact.forward_edges[forward_fill[from]++] = { to, connection.connection_type, connection.weight };
+    compact.reverse_edges[reverse_fill[to]++]   = { from, connection.connection_type, connection.weight };
+  }
+
+  if( lanes )
+    compact.set_positions( *lanes );
+
+  return compact;
+}
+
+CompactRoadGraph
+CompactRoadGraph::build( const RoadGraph& graph, const LanePositions& lane_positions )
+{
+  auto compact = build( graph );
+  compact.set_positions( lane_positions );
+  return compact;
+}
+
+LanePositions
+CompactRoadGraph::get_lane_positions() const
+{
+  if( positions.empty() )
+    return {};
+  return { lane_ids, positions };
+}
+
+void
+CompactRoadGraph::set_positions( const LaneStore& lanes )
+{
+  positions.resize( lane_ids.size() );
+  for( size_t node = 0; node < lane_ids.size(); ++node )
+  {
+    auto lane_it = lanes.find( lane_ids[node] );
+    if( lane_it == lanes.end() || !lane_it->second || lane_it->second->borders.center.interpolated_points.empty() )
+    {
+      positions.clear();
+      return;
+    }
+
+    // Lanes left of the reference line are driven against their point order
+    const auto& lane   = *lane_it->second;
+    const auto& points = lane.borders.center.interpolated_points;
+    const auto& entry  = lane.left_of_reference ? points.back() : points.front();
+    positions[node]    = { entry.x, entry.y };
+  }
+  set_heuristic_scale();
+}
+
+void
+CompactRoadGraph::set_positions( const LanePositions& lane_positions )
+{
+  positions.resize( lane_ids.size() );
+  for( size_t node = 0; node < lane_ids.size(); ++node )
+  {
+    const auto* position = lane_positions.find( lane_ids[node] );
+    if( !position )
+    {
+      positions.clear();
+      return;
+    }
+    positions[node] = *position;
+  }
+  set_heuristic_scale();
+}
+
+void
+CompactRoadGraph::set_heuristic_scale()
+{
+  // The largest scale for which no connection is cheaper than the scaled distance it bridges
+  double scale = std::numeric_limits<double>::infinity();
+  for( size_t node = 0; node < lane_ids.size(); ++node )
+  {
+    for( const auto& edge : get_successors( static_cast<NodeIndex>( node ) ) )
+    {
+      const double distance = std::hypot( positions[node].x - positions[edge.target].x, positions[node].y - positions[edge.target].y );
+      if( distance > 0.0 )
+        scale = std::min( scale, std::max( edge.weight, 0.0 ) / distance );
+    }
+  }
+
+  // Leave room for rounding in the sums along a path
+  heuristic_scale = std::isfinite( scale ) ? scale * ( 1.0 - 1e-9 ) : 0.0;
+}
+
+void
+CompactRoadGraph::set_landmarks( std::shared_ptr<const LandmarkIndex> landmark_index )
+{
+  landmarks = std::move( landmark_index );
+  landmark_rows.clear();
+  if( !landmarks )
+    return;
+
+  landmark_rows.resize( lane_ids.size() );
+  for( size_t node = 0; node < lane_ids.size(); ++node )
+    landmark_rows[node] = landmarks->find_row( lane_ids[node] );
+}
+
+std::deque<LaneID>
+CompactRoadGraph::find_path( LaneID from, LaneID to, bool allow_reverse, const std::function<bool( LaneID )>& lane_filter,
+                             const WeightOverlay* overlay ) const
+{
+  check_overlay( overlay, *this );
+
+  if( from == to )
+    return { from };
+
+  const NodeIndex source = find_node( from );
+  const NodeIndex target = find_node( to );
+  if( source == NO_NODE || target == NO_NODE )
+    return {};
+
+  // Estimates assume no connection got cheaper than in this graph
+  const bool use_estimates = !overlay || !overlay->lowers_weights();
+  auto       estimate      = [&]( NodeIndex node ) { return use_estimates ? estimate_cost( node, target, allow_reverse ) : 0.0; };
+
+  auto& labels = get_labels( node_count() );
+
+  // Ordered by cost plus the estimate of the remaining cost
+  using QueueEntry = std::pair<double, NodeIndex>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> pq;
+
+  labels.cost[source]     = 0.0;
+  labels.estimate[source] = estimate( source );
+  labels.previous[source] = NO_NODE;
+  labels.reached[source]  = labels.generation;
+  if( std::isinf( labels.estimate[source] ) )
+    return {};
+  pq.push( { labels.estimate[source], source } );
+
+  // Weights come from the overlay if there is one, closed connections are infinite
+  auto relax = [&]( NodeIndex current, std::span<const CompactEdge> edges, const double* weights ) {
+    const double current_cost = labels.cost[current];
+    for( size_t i = 0; i < edges.size(); ++i )
+    {
+      const auto&  edge   = edges[i];
+      const double weight = weights ? weights[i] : edge.weight;
+      if( std::isinf( weight ) || ( lane_filter && !lane_filter( lane_ids[edge.target] ) ) )
+        continue;
+
+      const double new_cost = current_cost + weight;
+      if( labels.improves( edge.target, new_cost ) )
+      {
+        if( labels.reached[edge.target] != labels.generation )
+          labels.estimate[edge.target] = estimate( edge.target );
+        labels.cost[edge.target]     = new_cost;
+        labels.previous[edge.target] = current;
+        labels.reached[edge.target]  = labels.generation;
+        if( !std::isinf( labels.estimate[edge.target] ) ) // else the target cannot be reached from there
+          pq.push( { new_cost + labels.estimate[edge.target], edge.target } );
+      }
+    }
+  };
+
+  // Landmark estimates are admissible but, rounded to float, not exactly consistent. Skipping only outdated
+  // queue entries instead of settled nodes lets a node that is reached cheaper later be expanded again.
+  while( !pq.empty() )
+  {
+    const auto [priority, current] = pq.top();
+    pq.pop();
+
+    if( priority > labels.cost[current] + labels.estimate[current] )
+      continue;
+
+    if( current == target )
+    {
+      std::deque<LaneID> path;
+      for( NodeIndex node = target; node != NO_NODE; node = labels.previous[node] )
+        path.push_front( lane_ids[node] );
+      return path;
+    }
+
+    relax( current, get_successors( current ), get_weights( overlay, current, true, true ) );
+    if( allow_reverse )
+      relax( current, get_predecessors( current ), get_weights( overlay, current, false, false ) );
+  }
+
+  return {};
+}
+
+std::deque<LaneID>
+CompactRoadGraph::find_path_bidirectional( LaneID from, LaneID to, bool allow_reverse,
+                                           const std::function<bool( LaneID )>& lane_filter, const WeightOverlay* overlay ) const
+{
+  check_overlay( overlay, *this );
+
+  if( from == to )
+    return { from };
+
+  const NodeIndex source = find_node( from );
+  const NodeIndex target = find_node( to );
+  if( source == NO_NODE || target == NO_NODE || ( lane_filter && !lane_filter( to ) ) )
+    return {};
+
+  using QueueEntry = std::pair<double, NodeIndex>;
+  using Queue      = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>>;
+
+  SearchLabels* labels[2] = { &get_labels( node_count(), 0 ), &get_labels( node_count(), 1 ) };
+  Queue         queues[2];
+  for( const size_t side : { 0, 1 } )
+  {
+    const NodeIndex start         = side == 0 ? source : target;
+    labels[side]->cost[start]     = 0.0;
+    labels[side]->previous[start] = NO_NODE;
+    labels[side]->reached[start]  = labels[side]->generation;
+    queues[side].push( { 0.0, start } );
+  }
+
+  // Cheapest known path through a node reached from both sides
+  double    best_cost = std::numeric_limits<double>::infinity();
+  NodeIndex meeting   = NO_NODE;
+
+  // The backward search walks the same edges against their direction: connections into a node, and with
+  // allow_reverse the connections out of it, which the forward search may traverse backwards. Parallel
+  // (lane change) connections are directed edges like all others, so both sides treat them alike. Overlay
+  // weights for following a connection are those of successors forward and of predecessors backward.
+  auto relax = [&]( size_t side, NodeIndex current, bool successors ) {
+    auto&         own          = *labels[side];
+    const auto&   other        = *labels[1 - side];
+    const double  current_cost = own.cost[current];
+    const auto    edges        = successors ? get_successors( current ) : get_predecessors( current );
+    const double* weights      = get_weights( overlay, current, successors, successors == ( side == 0 ) );
+    for( size_t i = 0; i < edges.size(); ++i )
+    {
+      const auto&  edge   = edges[i];
+      const double weight = weights ? weights[i] : edge.weight;
+
+      // The filter never applies to the start lane, also when the backward search reaches it
+      if( std::isinf( weight ) || ( lane_filter && !( side == 1 && edge.target == source ) && !lane_filter( lane_ids[edge.target] ) ) )
+        continue;
+
+      const double new_cost = current_cost + weight;
+      if( !own.improves( edge.target, new_cost ) )
+        continue;
+
+      own.cost[edge.target]     = new_cost;
+      own.previous[edge.target] = current;
+      own.reached[edge.target]  = own.generation;
+      queues[side].push( { new_cost, edge.target } );
+
+      if( other.reached[edge.target] == other.generation && new_cost + other.cost[edge.target] < best_cost )
+      {
+        best_cost = new_cost + other.cost[edge.target];
+        meeting   = edge.target;
+      }
+    }
+  };
+
+  // Expand the side with the cheaper frontier until no path through unsettled nodes can be cheaper
+  while( !queues[0].empty() && !queues[1].empty() && queues[0].top().first + queues[1].top().first < best_cost )
+  {
+    const size_t    side    = queues[0].top().first <= queues[1].top().first ? 0 : 1;
+    const NodeIndex current = queues[side].top().second;
+    queues[side].pop();
+
+    auto& own = *labels[side];
+    if( own.settled[current] == own.generation )
+      continue;
+    own.settled[current] = own.generation;
+
+    relax( side, current, side == 0 );
+    if( allow_reverse )
+      relax( side, current, side != 0 );
+  }
+
+  if( meeting == NO_NODE )
+    return {};
+
+  std::deque<LaneID> path;
+  for( NodeIndex node = meeting; node != NO_NODE; node = labels[0]->previous[node] )
+    path.push_front( lane_ids[node] );
+  for( NodeIndex node = labels[1]->previous[meeting]; node != NO_NODE; node = labels[1]->previous[node] )
+    path.push_back( lane_ids[node] );
+  return path;
+}
+
+ReachableSet
+CompactRoadGraph::find_reachable( LaneID from, double max_cost, SearchDirection direction, bool allow_lane_changes,
+                                  std::span<const LaneID> targets, const WeightOverlay* overlay ) const
+{
+  check_overlay( overlay, *this );
+
+  ReachableSet result;
+  result.direction = direction;
+  if( !( max_cost >= 0.0 ) )
+    return result;
+
+  auto add = [&]( LaneID lane_id, double cost, LaneID previous ) {
+    result.index.emplace( lane_id, result.lanes.size() );
+    result.lanes.push_back( { lane_id, cost, previous } );
+  };
+
+  const NodeIndex source = find_node( from );
+  if( source == NO_NODE )
+  {
+    add( from, 0.0, from );
+    return result;
+  }
+
+  // Targets in the graph, the search ends once all of them are settled
+  std::vector<NodeIndex> target_nodes;
+  for( const auto lane_id : targets )
+  {
+    const NodeIndex node = find_node( lane_id );
+    if( node != NO_NODE )
+      target_nodes.push_back( node );
+  }
+  std::sort( target_nodes.begin(), target_nodes.end() );
+  target_nodes.erase( std::unique( target_nodes.begin(), target_nodes.end() ), target_nodes.end() );
+  size_t targets_left = target_nodes.size();
+
+  auto& labels = get_labels( node_count() );
+
+  using QueueEntry = std::pair<double, NodeIndex>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> pq;
+
+  labels.cost[source]     = 0.0;
+  labels.previous[source] = source;
+  labels.reached[source]  = labels.generation;
+  pq.push( { 0.0, source } );
+
+  // BACKWARD searches follow the predecessor connections, the others the successor connections
+  auto relax = [&]( NodeIndex current, bool successors ) {
+    const double  current_cost = labels.cost[current];
+    const auto    edges        = successors ? get_successors( current ) : get_predecessors( current );
+    const double* weights      = get_weights( overlay, current, successors, successors != ( direction == BACKWARD ) );
+    for( size_t i = 0; i < edges.size(); ++i )
+    {
+      const auto&  edge   = edges[i];
+      const double weight = weights ? weights[i] : edge.weight;
+      if( std::isinf( weight ) || ( !allow_lane_changes && edge.type == PARALLEL ) )
+        continue;
+
+      const double new_cost = current_cost + weight;
+      if( new_cost <= max_cost && labels.settled[edge.target] != labels.generation && labels.improves( edge.target, new_cost ) )
+      {
+        labels.cost[edge.target]     = new_cost;
+        labels.previous[edge.target] = current;
+        labels.reached[edge.target]  = labels.generation;
+        pq.push( { new_cost, edge.target } );
+      }
+    }
+  };
+
+  // Only nodes within the budget are ever queued, so the search ends when the budget is used up
+  while( !pq.empty() )
+  {
+    const auto [current_cost, current] = pq.top();
+    pq.pop();
+
+    if( labels.settled[current] == labels.generation )
+      continue;
+    labels.settled[current] = labels.generation;
+    add( lane_ids[current], current_cost, lane_ids[labels.previous[current]] );
+    if( !target_nodes.empty() && std::binary_search( target_nodes.begin(), target_nodes.end(), current ) && --targets_left == 0 )
+      break;
+
+    if( direction != BACKWARD )
+      relax( current, true );
+    if( direction != FORWARD )
+      relax( current, false );
+  }
+
+  return result;
+}
+
+std::vector<double>
+CompactRoadGraph::shortest_costs( NodeIndex source, bool successors, bool predecessors, const WeightOverlay* overlay, bool to_source ) const
+{
+  check_overlay( overlay, *this );
+
+  std::vector<double> cost( node_count(), std::numeric_limits<double>::infinity() );
+  using QueueEntry = std::pair<double, NodeIndex>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> pq;
+
+  cost[source] = 0.0;
+  pq.push( { 0.0, source } );
+  // Paths from the source follow successor connections, paths to it predecessor connections
+  auto relax = [&]( NodeIndex current, double current_cost, bool forward ) {
+    const auto    edges   = forward ? get_successors( current ) : get_predecessors( current );
+    const double* weights = get_weights( overlay, current, forward, forward != to_source );
+    for( size_t i = 0; i < edges.size(); ++i )
+    {
+      const auto&  edge     = edges[i];
+      const double new_cost = current_cost + ( weights ? weights[i] : edge.weight );
+      if( new_cost < cost[edge.target] )
+      {
+        cost[edge.target] = new_cost;
+        pq.push( { new_cost, edge.target } );
+      }
+    }
+  };
+
+  while( !pq.empty() )
+  {
+    const auto [current_cost, current] = pq.top();
+    pq.pop();
+    if( current_cost > cost[current] )
+      continue;
+    if( successors )
+      relax( current, current_cost, true );
+    if( predecessors )
+      relax( current, current_cost, false );
+  }
+  return cost;
+}
+
+bool
+CompactRoadGraph::find_spur_path( NodeIndex source, NodeIndex target, bool allow_reverse, const std::vector<double>& to_target,
+                                  const std::vector<uint32_t>& blocked, uint32_t stamp, std::span<const NodeIndex> excluded,
+                                  double max_cost, std::vector<NodeIndex>& nodes, std::vector<double>& costs,
+                                  const WeightOverlay* overlay ) const
+{
+  auto& labels = get_labels( node_count() );
+
+  using QueueEntry = std::pair<double, NodeIndex>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> pq;
+
+  labels.cost[source]     = 0.0;
+  labels.estimate[source] = to_target[source];
+  labels.previous[source] = NO_NODE;
+  labels.reached[source]  = labels.generation;
+  if( std::isinf( labels.estimate[source] ) || labels.estimate[source] > max_cost )
+    return false;
+  pq.push( { labels.estimate[source], source } );
+
+  auto relax = [&]( NodeIndex current, std::span<const CompactEdge> edges, const double* weights ) {
+    const double current_cost = labels.cost[current];
+    for( size_t i = 0; i < edges.size(); ++i )
+    {
+      const auto&  edge   = edges[i];
+      const double weight = weights ? weights[i] : edge.weight;
+      if( std::isinf( weight ) || blocked[edge.target] == stamp
+          || ( current == source && std::find( excluded.begin(), excluded.end(), edge.target ) != excluded.end() ) )
+        continue;
+
+      const double new_cost = current_cost + weight;
+      if( !labels.improves( edge.target, new_cost ) )
+        continue;
+
+      // Nodes from which the target cannot be reached within the budget are never queued
+      const double estimate = to_target[edge.target];
+      if( std::isinf( estimate ) || new_cost + estimate > max_cost )
+        continue;
+
+      labels.cost[edge.target]     = new_cost;
+      labels.estimate[edge.target] = estimate;
+      labels.previous[edge.target] = current;
+      labels.reached[edge.target]  = labels.generation;
+      pq.push( { new_cost + estimate, edge.target } );
+    }
+  };
+
+  while( !pq.empty() )
+  {
+    const auto [priority, current] = pq.top();
+    pq.pop();
+
+    if( priority > labels.cost[current] + labels.estimate[current] )
+      continue;
+
+    if( current == target )
+    {
+      nodes.clear();
+      costs.clear();
+      for( NodeIndex node = target; node != NO_NODE; node = labels.previous[node] )
+      {
+        nodes.push_back( node );
+        costs.push_back( labels.cost[node] );
+      }
+      std::reverse( nodes.begin(), nodes.end() );
+      std::reverse( costs.begin(), costs.end() );
+      return true;
+    }
+
+    relax( current, get_successors( current ), get_weights( overlay, current, true, true ) );
+    if( allow_reverse )
+      relax( current, get_predecessors( current ), get_weights( overlay, current, false, false ) );
+  }
+
+  return false;
+}
+
+std::vector<std::deque<LaneID>>
+CompactRoadGraph::find_alternative_paths( LaneID from, LaneID to, const AlternativeRouteConfig& config,
+                                          const WeightOverlay* overlay ) const
+{
+  check_overlay( overlay, *this );
+
+  if( config.route_count == 0 )
+    return {};
+  if( from == to )
+    return { { from } };
+
+  const NodeIndex source = find_node( from );
+  const NodeIndex target = find_node( to );
+  if( source == NO_NODE || target == NO_NODE )
+    return {};
+
+  // Loopless path with the cost from the start to each of its nodes, deviating from the path it was
+  // derived from at node deviation
+  struct Candidate
+  {
+    std::vector<NodeIndex> nodes;
+    std::vector<double>    costs;
+    size_t                 deviation = 0;
+  };
+
+  std::vector<uint32_t> blocked( node_count(), 0 );
+  uint32_t              stamp = 1;
+
+  // Exact costs to the target bound those with parts of the graph blocked, so spur searches run A* on them
+  // and expand little more than the nodes of their path
+  const auto to_target = shortest_costs( target, config.allow_reverse, true, overlay, true );
+
+  std::vector<Candidate> found( 1 ); // in ascending cost, the first one is the shortest path
+  if( !find_spur_path( source, target, config.allow_reverse, to_target, blocked, stamp, {}, std::numeric_limits<double>::infinity(),
+                       found[0].nodes, found[0].costs, overlay ) )
+    return {};
+  const double max_cost = config.max_cost_factor * found[0].costs.back();
+
+  // Paths are accepted if little of their cost lies on steps of paths accepted before
+  std::vector<size_t>          accepted;
+  std::unordered_set<uint64_t> accepted_steps;
+  auto step_key = []( NodeIndex a, NodeIndex b ) { return static_cast<uint64_t>( a ) << 32 | b; };
+  auto consider = [&]( size_t index ) {
+    const auto& path    = found[index];
+    double      overlap = 0.0;
+    for( size_t j = 0; j + 1 < path.nodes.size(); ++j )
+    {
+      if( accepted_steps.count( step_key( path.nodes[j], path.nodes[j + 1] ) ) )
+        overlap += path.costs[j + 1] - path.costs[j];
+    }
+    if( !accepted.empty() && overlap > config.max_overlap * path.costs.back() )
+      return;
+
+    accepted.push_back( index );
+    for( size_t j = 0; j + 1 < path.nodes.size(); ++j )
+      accepted_steps.insert( step_key( path.nodes[j], path.nodes[j + 1] ) );
+  };
+  consider( 0 );
+
+  // Candidates not examined yet, cheapest first
+  using QueueEntry = std::pair<double, size_t>;
+  std::vector<Candidate>                                                   pool;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> candidates;
+  std::set<std::vector<NodeIndex>>                                         seen{ found[0].nodes };
+
+  std::vector<NodeIndex> excluded, spur_nodes;
+  std::vector<double>    spur_costs;
+  while( accepted.size() < config.route_count && found.size() < config.candidate_limit )
+  {
+    // Spurs from every node of the newest path after the one it deviated at (earlier spurs were tried for
+    // the path it came from), each avoiding the root before it and the steps other paths take from there
+    const size_t last = found.size() - 1;
+    for( size_t i = found[last].deviation; i + 1 < found[last].nodes.size(); ++i )
+    {
+      const auto&  path      = found[last];
+      const double root_cost = path.costs[i];
+
+      ++stamp;
+      for( size_t j = 0; j < i; ++j )
+        blocked[path.nodes[j]] = stamp;
+
+      excluded.clear();
+      for( const auto& other : found )
+      {
+        if( other.nodes.size() > i + 1 && std::equal( path.nodes.begin(), path.nodes.begin() + i + 1, other.nodes.begin() ) )
+          excluded.push_back( other.nodes[i + 1] );
+      }
+
+      if( !find_spur_path( path.nodes[i], target, config.allow_reverse, to_target, blocked, stamp, excluded, max_cost - root_cost,
+                           spur_nodes, spur_costs, overlay ) )
+        continue;
+
+      Candidate candidate;
+      candidate.nodes.assign( path.nodes.begin(), path.nodes.begin() + i );
+      candidate.costs.assign( path.costs.begin(), path.costs.begin() + i );
+      candidate.nodes.insert( candidate.nodes.end(), spur_nodes.begin(), spur_nodes.end() );
+      for( const double cost : spur_costs )
+        candidate.costs.push_back( root_cost + cost );
+      candidate.deviation = i;
+      if( !seen.insert( candidate.nodes ).second )
+        continue;
+
+      candidates.push( { candidate.costs.back(), pool.size() } );
+      pool.push_back( std::move( candidate ) );
+    }
+
+    if( candidates.empty() )
+      break;
+    found.push_back( std::move( pool[candidates.top().second] ) );
+    candidates.pop();
+    consider( found.size() - 1 );
+  }
+
+  std::vector<std::deque<LaneID>> paths;
+  for( const auto index : accepted )
+  {
+    std::deque<LaneID> path;
+    for( const auto node : found[index].nodes )
+      path.push_back( lane_ids[node] );
+    paths.push_back( std::move( path ) );
+  }
+  return paths;
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,775 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/compiled_map.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace adore
+{
+namespace map
+{
+
+namespace
+{
+
+using namespace compiled;
+
+constexpr size_t SECTION_ALIGNMENT = 8;
+
+// Deepest quadtree accepted from a file, far beyond what point densities of real maps produce
+constexpr uint32_t MAX_INDEX_DEPTH = 256;
+
+// Orders connections by their start lane, for lookups by lane id
+struct ConnectionFromLess
+{
+  bool
+  operator()( const ConnectionRecord& connection, LaneID id ) const
+  {
+    return connection.from_id < id;
+  }
+
+  bool
+  operator()( LaneID id, const ConnectionRecord& connection ) const
+  {
+    return id < connection.from_id;
+  }
+};
+
+size_t
+align_up( size_t offset )
+{
+  return ( offset + SECTION_ALIGNMENT - 1 ) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+
+// Typed contents of all sections, collected before they are laid out in one buffer
+struct SectionBuffers
+{
+  std::vector<PointRecord>      points;
+  std::vector<SplineRecord>     splines;
+  std::vector<double>           spline_values;
+  std::vector<LaneRecord>       lanes;
+  std::vector<RoadRecord>       roads;
+  std::vector<uint64_t>         road_lane_ids;
+  std::vector<char>             names;
+  std::vector<ConnectionRecord> connections;
+  std::vector<uint64_t>         predecessors;
+  std::vector<IndexNodeRecord>  index_nodes;
+  std::vector<PointRecord>      index_points;
+};
+
+PointRecord
+to_record( const MapPoint& point )
+{
+  PointRecord record{};
+  record.x             = point.x;
+  record.y             = point.y;
+  record.s             = point.s;
+  record.max_speed     = point.max_speed.value_or( 0.0 );
+  record.parent_id     = point.parent_id;
+  record.has_max_speed = point.max_speed.has_value() ? 1 : 0;
+  return record;
+}
+
+Range
+append_points( std::vector<PointRecord>& records, const std::vector<MapPoint>& points )
+{
+  Range range{ records.size(), points.size() };
+  for( const auto& point : points )
+    records.push_back( to_record( point ) );
+  return range;
+}
+
+uint64_t
+append_spline( SectionBuffers& buffers, const BorderSpline& spline )
+{
+  const auto& distances = spline.get_distances();
+  const auto  x         = spline.get_x_coefficients();
+  const auto  y         = spline.get_y_coefficients();
+
+  SplineRecord record{ buffers.spline_values.size(), distances.size() - 1 };
+  auto&        values = buffers.spline_values;
+  values.insert( values.end(), distances.begin(), distances.end() );
+  for( const auto* coefficients : { &x, &y } )
+  {
+    values.insert( values.end(), coefficients->a.begin(), coefficients->a.end() );
+    values.insert( values.end(), coefficients->b.begin(), coefficients->b.end() );
+    values.insert( values.end(), coefficients->c.begin(), coefficients->c.end() );
+    values.insert( values.end(), coefficients->d.begin(), coefficients->d.end() );
+  }
+
+  buffers.splines.push_back( record );
+  return buffers.splines.size() - 1;
+}
+
+BorderRecord
+append_border( SectionBuffers& buffers, const Border& border )
+{
+  BorderRecord record{};
+  record.points              = append_points( buffers.points, border.points );
+  record.interpolated_points = append_points( buffers.points, border.interpolated_points );
+  record.length              = border.length;
+  record.spline              = border.spline ? append_spline( buffers, *border.spline ) : NONE;
+  return record;
+}
+
+// Fills in the child indices of a preorder node sequence, returns the index after the subtree at node_index
+uint64_t
+link_index_nodes( std::vector<IndexNodeRecord>& nodes, uint64_t node_index )
+{
+  if( node_index >= nodes.size() )
+    throw std::runtime_error( "Compiled map: quadtree node sequence is truncated" );
+
+  auto&    node  = nodes[node_index];
+  uint64_t child = node_index + 1;
+  if( node.children[0] == NONE )
+    return child;
+
+  for( auto& child_index : node.children )
+  {
+    child_index = child;
+    child       = link_index_nodes( nodes, child );
+  }
+  return child;
+}
+
+template<typename Record>
+void
+write_section( std::vector<std::byte>& buffer, SectionEntry& entry, const std::vector<Record>& records )
+{
+  entry.offset = buffer.size();
+  entry.count  = records.size();
+  if( !records.empty() )
+  {
+    const auto* begin = reinterpret_cast<const std::byte*>( records.data() );
+    buffer.insert( buffer.end(), begin, begin + records.size() * sizeof( Record ) );
+  }
+  buffer.resize( align_up( buffer.size() ) );
+}
+
+std::vector<MapPoint>
+read_points( std::span<const PointRecord> records, const Range& range )
+{
+  std::vector<MapPoint> points;
+  points.reserve( range.count );
+  for( const auto& record : sub_range( records, range ) )
+    points.push_back( to_map_point( record ) );
+  return points;
+}
+
+} // namespace
+
+std::vector<std::byte>
+compile_map( const Map& map )
+{
+  SectionBuffers buffers;
+
+  // Lanes are stored by id, so lookups in the compiled map are a binary search
+  std::vector<LaneID> lane_ids;
+  lane_ids.reserve( map.lanes.size() );
+  for( const auto& [lane_id, lane] : map.lanes )
+  {
+    if( lane )
+      lane_ids.push_back( lane_id );
+  }
+  std::sort( lane_ids.begin(), lane_ids.end() );
+
+  buffers.lanes.reserve( lane_ids.size() );
+  for( const auto& lane_id : lane_ids )
+  {
+    const auto& lane = map.lanes.at( lane_id );
+
+    LaneRecord record{};
+    record.id                = lane_id;
+    record.road_id           = lane->road_id;
+    record.length            = lane->length;
+    record.speed_limit       = lane->speed_limit;
+    record.type              = static_cast<uint32_t>( lane->type );
+    record.material          = static_cast<uint32_t>( lane->material );
+    record.left_of_reference = lane->left_of_reference ? 1 : 0;
+    record.inner             = append_border( buffers, lane->borders.inner );
+    record.outer             = append_border( buffers, lane->borders.outer );
+    record.center            = append_border( buffers, lane->borders.center );
+    buffers.lanes.push_back( record );
+  }
+
+  for( const auto& [road_id, road] : map.roads )
+  {
+    RoadRecord record{};
+    record.id       = road_id;
+    record.category = static_cast<uint32_t>( road.category );
+    record.one_way  = road.one_way ? 1 : 0;
+    record.name     = { buffers.names.size(), road.name.size() };
+    record.lane_ids = { buffers.road_lane_ids.size(), road.lane_ids.size() };
+    buffers.names.insert( buffers.names.end(), road.name.begin(), road.name.end() );
+    buffers.road_lane_ids.insert( buffers.road_lane_ids.end(), road.lane_ids.begin(), road.lane_ids.end() );
+    buffers.roads.push_back( record );
+  }
+
+  for( const auto& connection : map.lane_graph.all_connections )
+  {
+    ConnectionRecord record{};
+    record.from_id         = connection.from_id;
+    record.to_id           = connection.to_id;
+    record.weight          = connection.weight;
+    record.connection_type = static_cast<uint32_t>( connection.connection_type );
+    buffers.connections.push_back( record );
+  }
+  // Connections come from a hash set, sort them so equal maps compile to equal files
+  std::sort( buffers.connections.begin(), buffers.connections.end(),
+             []( const auto& a, const auto& b ) { return std::tie( a.from_id, a.to_id ) < std::tie( b.from_id, b.to_id ); } );
+
+  const auto& connections = buffers.connections;
+  buffers.predecessors.resize( connections.size() );
+  std::iota( buffers.predecessors.begin(), buffers.predecessors.end(), 0 );
+  std::sort( buffers.predecessors.begin(), buffers.predecessors.end(), [&]( uint64_t a, uint64_t b ) {
+    return std::tie( connections[a].to_id, connections[a].from_id ) < std::tie( connections[b].to_id, connections[b].from_id );
+  } );
+
+  map.quadtree.visit_nodes( [&]( const auto& boundary, const std::vector<MapPoint>& node_points, bool divided ) {
+    IndexNodeRecord node{};
+    node.x_min  = boundary.x_min;
+    node.x_max  = boundary.x_max;
+    node.y_min  = boundary.y_min;
+    node.y_max  = boundary.y_max;
+    node.points = append_points( buffers.index_points, node_points );
+    std::fill( std::begin( node.children ), std::end( node.children ), divided ? 0 : NONE );
+    buffers.index_nodes.push_back( node );
+  } );
+  link_index_nodes( buffers.index_nodes, 0 );
+
+  std::vector<std::byte> buffer( align_up( sizeof( Header ) ) );
+  Header                 header{};
+  std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+  header.version        = FORMAT_VERSION;
+  header.endian_marker  = ENDIAN_MARKER;
+  header.index_capacity = map.quadtree.capacity;
+
+  write_section( buffer, header.sections[POINTS], buffers.points );
+  write_section( buffer, header.sections[SPLINES], buffers.splines );
+  write_section( buffer, header.sections[SPLINE_VALUES], buffers.spline_values );
+  write_section( buffer, header.sections[LANES], buffers.lanes );
+  write_section( buffer, header.sections[ROADS], buffers.roads );
+  write_section( buffer, header.sections[ROAD_LANE_IDS], buffers.road_lane_ids );
+  write_section( buffer, header.sections[NAMES], buffers.names );
+  write_section( buffer, header.sections[CONNECTIONS], buffers.connections );
+  write_section( buffer, header.sections[PREDECESSORS], buffers.predecessors );
+  write_section( buffer, header.sections[INDEX_NODES], buffers.index_nodes );
+  write_section( buffer, header.sections[INDEX_POINTS], buffers.index_points );
+
+  header.file_size = buffer.size();
+  std::memcpy( buffer.data(), &header, sizeof( Header ) );
+  return buffer;
+}
+
+void
+write_compiled_map( const Map& map, const std::string& file_location )
+{
+  const auto buffer = compile_map( map );
+
+  // Readers may have the old file mapped, truncating it under them would fault their next read. Write a
+  // new file next to it and rename it over the old one, the mappings keep the old inode.
+  const std::string temporary_location = file_location + ".tmp";
+  std::ofstream     file( temporary_location, std::ios::binary | std::ios::trunc );
+  if( !file )
+    throw std::runtime_error( "Failed to open compiled map file for writing: " + temporary_location );
+
+  file.write( reinterpret_cast<const char*>( buffer.data() ), static_cast<std::streamsize>( buffer.size() ) );
+  file.close();
+  if( !file || std::rename( temporary_location.c_str(), file_location.c_str() ) != 0 )
+  {
+    std::remove( temporary_location.c_str() );
+    throw std::runtime_error( "Failed to write compiled map file: " + file_location );
+  }
+}
+
+CompiledMap::CompiledMap( std::shared_ptr<const void> storage_, const std::byte* data_, size_t size_ ) :
+  storage( std::move( storage_ ) ),
+  data( data_ ),
+  data_size( size_ )
+{
+  if( !data || data_size < sizeof( Header ) )
+    throw std::runtime_error( "Compiled map: buffer too small for header" );
+  if( reinterpret_cast<uintptr_t>( data ) % SECTION_ALIGNMENT != 0 )
+    throw std::runtime_error( "Compiled map: buffer is not 8 byte aligned" );
+
+  // SharedMap::publish stores the magic last with release semantics, this acquire load makes the rest
+  // of a shared segment visible once the magic matches
+  static_assert( offsetof( Header, magic ) == 0 && sizeof( Header::magic ) == sizeof( uint64_t ) );
+  auto&    magic_word = *reinterpret_cast<uint64_t*>( const_cast<std::byte*>( data ) );
+  uint64_t magic      = std::atomic_ref<uint64_t>( magic_word ).load( std::memory_order_acquire );
+  if( std::memcmp( &magic, MAGIC, sizeof( MAGIC ) ) != 0 )
+    throw std::runtime_error( "Compiled map: not a compiled map (bad magic)" );
+
+  const auto& header = get_header();
+  if( header.endian_marker != ENDIAN_MARKER )
+    throw std::runtime_error( "Compiled map: written with a different byte order" );
+  if( header.version != FORMAT_VERSION )
+    throw std::runtime_error( "Compiled map: unsupported format version " + std::to_string( header.version ) );
+  if( header.file_size != data_size )
+    throw std::runtime_error( "Compiled map: size does not match header (truncated file?)" );
+
+  const size_t record_sizes[SECTION_COUNT] = { sizeof( PointRecord ),      sizeof( SplineRecord ),     sizeof( double ),
+                                               sizeof( LaneRecord ),       sizeof( RoadRecord ),       sizeof( uint64_t ),
+                                               sizeof( char ),             sizeof( ConnectionRecord ), sizeof( uint64_t ),
+                                               sizeof( IndexNodeRecord ),  sizeof( PointRecord ) };
+  for( uint32_t section = 0; section < SECTION_COUNT; ++section )
+  {
+    const auto& entry = header.sections[section];
+    if( entry.offset % SECTION_ALIGNMENT != 0 || entry.offset < sizeof( Header ) || entry.offset > data_size
+        || entry.count > ( data_size - entry.offset ) / record_sizes[section] )
+      throw std::runtime_error( "Compiled map: section " + std::to_string( section ) + " out of bounds" );
+  }
+
+  validate_records();
+}
+
+void
+CompiledMap::validate_records() const
+{
+  // Lookups binary search lanes, connections and the predecessor order
+  const auto lane_records = lanes();
+  for( size_t i = 1; i < lane_records.size(); ++i )
+  {
+    if( !( lane_records[i - 1].id < lane_records[i].id ) )
+      throw std::runtime_error( "Compiled map: lanes are not sorted by id" );
+  }
+
+  const auto connection_records = connections();
+  for( size_t i = 1; i < connection_records.size(); ++i )
+  {
+    const auto& a = connection_records[i - 1];
+    const auto& b = connection_records[i];
+    if( !( std::tie( a.from_id, a.to_id ) < std::tie( b.from_id, b.to_id ) ) )
+      throw std::runtime_error( "Compiled map: connections are not sorted" );
+  }
+
+  const auto order = predecessors();
+  for( size_t i = 0; i < order.size(); ++i )
+  {
+    if( order[i] >= connection_records.size() )
+      throw std::runtime_error( "Compiled map: predecessor index out of range" );
+    if( i > 0 )
+    {
+      const auto& a = connection_records[order[i - 1]];
+      const auto& b = connection_records[order[i]];
+      if( !( std::tie( a.to_id, a.from_id ) < std::tie( b.to_id, b.from_id ) ) )
+        throw std::runtime_error( "Compiled map: predecessors are not sorted" );
+    }
+  }
+
+  // The quadtree must be a tree in preorder: children come after their parent, every node but the root
+  // has exactly one parent, and the depth is bounded so recursive queries cannot overflow the stack
+  const auto            nodes = index_nodes();
+  const auto            point_count = index_points().size();
+  std::vector<uint32_t> depth( nodes.size(), 0 );
+  std::vector<bool>     has_parent( nodes.size(), false );
+  for( size_t i = 0; i < nodes.size(); ++i )
+  {
+    const auto& node = nodes[i];
+    if( node.points.first > point_count || node.points.count > point_count - node.points.first )
+      throw std::runtime_error( "Compiled map: quadtree points out of bounds" );
+    if( i > 0 && !has_parent[i] )
+      throw std::runtime_error( "Compiled map: quadtree node without parent" );
+
+    const bool leaf = node.children[0] == NONE;
+    for( const auto child : node.children )
+    {
+      if( leaf != ( child == NONE ) )
+        throw std::runtime_error( "Compiled map: quadtree node with missing children" );
+      if( leaf )
+        continue;
+      if( child <= i || child >= nodes.size() || has_parent[child] )
+        throw std::runtime_error( "Compiled map: quadtree child index invalid" );
+      has_parent[child] = true;
+      depth[child]      = depth[i] + 1;
+      if( depth[child] > MAX_INDEX_DEPTH )
+        throw std::runtime_error( "Compiled map: quadtree too deep" );
+    }
+  }
+}
+
+CompiledMap
+CompiledMap::open( const std::string& file_location )
+{
+  int fd = ::open( file_location.c_str(), O_RDONLY | O_CLOEXEC );
+  if( fd < 0 )
+    throw std::runtime_error( "Failed to open compiled map file: " + file_location );
+
+  struct stat file_stat;
+  if( ::fstat( fd, &file_stat ) != 0 || file_stat.st_size <= 0 )
+  {
+    ::close( fd );
+    throw std::runtime_error( "Failed to stat compiled map file: " + file_location );
+  }
+
+  const size_t size    = static_cast<size_t>( file_stat.st_size );
+  void*        address = ::mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+  ::close( fd );
+  if( address == MAP_FAILED )
+    throw std::runtime_error( "Failed to memory map compiled map file: " + file_location );
+
+  std::shared_ptr<const void> mapping( address, [size]( const void* p ) { ::munmap( const_cast<void*>( p ), size ); } );
+  return CompiledMap( mapping, static_cast<const std::byte*>( address ), size );
+}
+
+CompiledMap
+CompiledMap::from_buffer( std::vector<std::byte> buffer )
+{
+  // Copy into 8 byte aligned storage, a vector of bytes gives no alignment guarantee
+  auto words = std::make_shared<std::vector<uint64_t>>( ( buffer.size() + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t ) );
+  if( !buffer.empty() )
+    std::memcpy( words->data(), buffer.data(), buffer.size() );
+  const auto* bytes = reinterpret_cast<const std::byte*>( words->data() );
+  return CompiledMap( words, bytes, buffer.size() );
+}
+
+template<typename Record>
+std::span<const Record>
+CompiledMap::get_section( Section section ) const
+{
+  if( !data )
+    return {};
+  const auto& entry = get_header().sections[section];
+  return { reinterpret_cast<const Record*>( data + entry.offset ), static_cast<size_t>( entry.count ) };
+}
+
+std::span<const PointRecord>
+CompiledMap::points() const
+{
+  return get_section<PointRecord>( POINTS );
+}
+
+std::span<const SplineRecord>
+CompiledMap::splines() const
+{
+  return get_section<SplineRecord>( SPLINES );
+}
+
+std::span<const double>
+CompiledMap::spline_values() const
+{
+  return get_section<double>( SPLINE_VALUES );
+}
+
+std::span<const LaneRecord>
+CompiledMap::lanes() const
+{
+  return get_section<LaneRecord>( LANES );
+}
+
+std::span<const RoadRecord>
+CompiledMap::roads() const
+{
+  return get_section<RoadRecord>( ROADS );
+}
+
+std::span<const uint64_t>
+CompiledMap::road_lane_ids() const
+{
+  return get_section<uint64_t>( ROAD_LANE_IDS );
+}
+
+std::span<const char>
+CompiledMap::names() const
+{
+  return get_section<char>( NAMES );
+}
+
+std::span<const ConnectionRecord>
+CompiledMap::connections() const
+{
+  return get_section<ConnectionRecord>( CONNECTIONS );
+}
+
+std::span<const uint64_t>
+CompiledMap::predecessors() const
+{
+  return get_section<uint64_t>( PREDECESSORS );
+}
+
+std::span<const IndexNodeRecord>
+CompiledMap::index_nodes() const
+{
+  return get_section<IndexNodeRecord>( INDEX_NODES );
+}
+
+std::span<const PointRecord>
+CompiledMap::index_points() const
+{
+  return get_section<PointRecord>( INDEX_POINTS );
+}
+
+BorderSpline
+CompiledMap::read_spline( uint64_t spline_index ) const
+{
+  const auto&  record = at( splines(), spline_index );
+  const size_t n      = record.segment_count;
+
+  // Checked before 9 * n + 3 is formed, a corrupt segment count could wrap it into range
+  const size_t value_count = spline_values().size();
+  if( value_count < 3 || n > ( value_count - 3 ) / 9 )
+    throw std::runtime_error( "Compiled map: spline segment count out of bounds" );
+  const auto values = sub_range( spline_values(), Range{ record.first_value, 9 * n + 3 } );
+
+  size_t offset = 0;
+  auto   take   = [&]( size_t count ) {
+    std::vector<double> taken( values.begin() + offset, values.begin() + offset + count );
+    offset += count;
+    return taken;
+  };
+
+  std::vector<double>        distances = take( n + 1 );
+  BorderSpline::Coefficients x{ take( n ), take( n ), take( n + 1 ), take( n ) };
+  BorderSpline::Coefficients y{ take( n ), take( n ), take( n + 1 ), take( n ) };
+  return BorderSpline( std::move( distances ), std::move( x ), std::move( y ) );
+}
+
+Border
+CompiledMap::read_border( const BorderRecord& record ) const
+{
+  Border border;
+  border.points              = read_points( points(), record.points );
+  border.interpolated_points = read_points( points(), record.interpolated_points );
+  border.length              = record.length;
+  if( record.spline != NONE )
+    border.spline = read_spline( record.spline );
+  return border;
+}
+
+std::shared_ptr<Lane>
+CompiledMap::read_lane( const LaneRecord& record ) const
+{
+  auto lane               = std::make_shared<Lane>();
+  lane->id                = record.id;
+  lane->road_id           = record.road_id;
+  lane->length            = record.length;
+  lane->speed_limit       = record.speed_limit;
+  lane->type              = static_cast<LaneType>( record.type );
+  lane->material          = static_cast<LaneMaterial>( record.material );
+  lane->left_of_reference = record.left_of_reference != 0;
+  lane->borders.inner     = read_border( record.inner );
+  lane->borders.outer     = read_border( record.outer );
+  lane->borders.center    = read_border( record.center );
+  return lane;
+}
+
+const LaneRecord*
+CompiledMap::find_lane( LaneID lane_id ) const
+{
+  const auto records = lanes();
+  auto it = std::lower_bound( records.begin(), records.end(), lane_id, []( const LaneRecord& record, LaneID id ) { return record.id < id; } );
+  if( it == records.end() || it->id != lane_id )
+    return nullptr;
+  return &*it;
+}
+
+std::span<const PointRecord>
+CompiledMap::get_points( const Range& range ) const
+{
+  return sub_range( points(), range );
+}
+
+std::shared_ptr<Lane>
+CompiledMap::make_lane( LaneID lane_id ) const
+{
+  const auto* record = find_lane( lane_id );
+  return record ? read_lane( *record ) : nullptr;
+}
+
+std::span<const ConnectionRecord>
+CompiledMap::get_successors( LaneID lane_id ) const
+{
+  const auto records = connections();
+  auto [first, last] = std::equal_range( records.begin(), records.end(), lane_id, ConnectionFromLess{} );
+  return { first, last };
+}
+
+std::vector<const ConnectionRecord*>
+CompiledMap::get_predecessors( LaneID lane_id ) const
+{
+  const auto records = connections();
+  const auto order   = predecessors();
+
+  auto to_id_less = [&]( uint64_t connection_index, LaneID id ) { return at( records, connection_index ).to_id < id; };
+  auto it         = std::lower_bound( order.begin(), order.end(), lane_id, to_id_less );
+
+  std::vector<const ConnectionRecord*> found;
+  for( ; it != order.end() && at( records, *it ).to_id == lane_id; ++it )
+    found.push_back( &records[*it] );
+  return found;
+}
+
+std::vector<LaneID>
+CompiledMap::get_lane_ids_in( const Boundary& window ) const
+{
+  std::vector<LaneID> lane_ids;
+  const auto          nodes = index_nodes();
+  if( nodes.empty() )
+    return lane_ids;
+
+  std::vector<uint64_t> stack{ 0 };
+  while( !stack.empty() )
+  {
+    const auto& node = at( nodes, stack.back() );
+    stack.pop_back();
+
+    const Boundary boundary{ node.x_min, node.x_max, node.y_min, node.y_max };
+    if( !boundary.intersects( window ) )
+      continue;
+
+    for( const auto& point : sub_range( index_points(), node.points ) )
+    {
+      if( window.contains( point ) )
+        lane_ids.push_back( point.parent_id );
+    }
+
+    if( node.children[0] != NONE )
+      stack.insert( stack.end(), std::begin( node.children ), std::end( node.children ) );
+  }
+
+  std::sort( lane_ids.begin(), lane_ids.end() );
+  lane_ids.erase( std::unique( lane_ids.begin(), lane_ids.end() ), lane_ids.end() );
+  return lane_ids;
+}
+
+std::deque<LaneID>
+CompiledMap::find_path( LaneID from, LaneID to, bool allow_reverse ) const
+{
+  using QueueEntry = std::pair<double, LaneID>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> pq;
+
+  std::unordered_map<LaneID, double> shortest_paths;
+  std::unordered_map<LaneID, LaneID> previous_lanes;
+  std::unordered_set<LaneID>         visited;
+
+  pq.push( { 0.0, from } );
+  shortest_paths[from] = 0.0;
+
+  auto relax = [&]( LaneID current, LaneID neighbor, double new_cost ) {
+    auto it = shortest_paths.find( neighbor );
+    if( it == shortest_paths.end() || new_cost < it->second )
+    {
+      shortest_paths[neighbor] = new_cost;
+      previous_lanes[neighbor] = current;
+      pq.push( { new_cost, neighbor } );
+    }
+  };
+
+  while( !pq.empty() )
+  {
+    auto [current_cost, current] = pq.top();
+    pq.pop();
+
+    if( !visited.insert( current ).second )
+      continue;
+
+    if( current == to )
+    {
+      std::deque<LaneID> path{ to };
+      while( path.front() != from )
+        path.push_front( previous_lanes.at( path.front() ) );
+      return path;
+    }
+
+    for( const auto& connection : get_successors( current ) )
+      relax( current, connection.to_id, current_cost + connection.weight );
+
+    if( allow_reverse )
+    {
+      for( const auto* connection : get_predecessors( current ) )
+        relax( current, connection->from_id, current_cost + connection->weight );
+    }
+  }
+
+  return {};
+}
+
+Map
+CompiledMap::to_map() const
+{
+  Map map;
+  if( !data )
+    return map;
+
+  const auto lane_records = lanes();
+  map.lanes.reserve( lane_records.size() );
+  for( const auto& record : lane_records )
+    map.lanes.insert( read_lane( record ) );
+
+  const auto name_data    = names();
+  const auto lane_id_data = road_lane_ids();
+  for( const auto& record : roads() )
+  {
+    const auto name     = sub_range( name_data, record.name );
+    const auto lane_ids = sub_range( lane_id_data, record.lane_ids );
+
+    Road road;
+    road.id       = record.id;
+    road.category = static_cast<RoadCategory>( record.category );
+    road.one_way  = record.one_way != 0;
+    road.name.assign( name.begin(), name.end() );
+    road.lane_ids.assign( lane_ids.begin(), lane_ids.end() );
+    map.roads.emplace( road.id, std::move( road ) );
+  }
+
+  for( const auto& record : connections() )
+  {
+    Connection connection;
+    connection.from_id         = record.from_id;
+    connection.to_id           = record.to_id;
+    connection.weight          = record.weight;
+    connection.connection_type = static_cast<ConnectionType>( record.connection_type );
+    map.lane_graph.add_connection( connection );
+  }
+
+  const auto node_records = index_nodes();
+  if( !node_records.empty() )
+  {
+    const auto index_point_records = index_points();
+    size_t     next_node           = 0;
+
+    auto read_node = [&]() {
+      const auto&                  record = at( node_records, next_node++ );
+      Quadtree<MapPoint>::NodeData node;
+      node.boundary = { record.x_min, record.x_max, record.y_min, record.y_max };
+      node.points   = read_points( index_point_records, record.points );
+      node.divided  = record.children[0] != NONE;
+      return node;
+    };
+    map.quadtree = Quadtree<MapPoint>::restore( read_node, get_header().index_capacity );
+  }
+
+  map.lane_graph.build_compact( &map.lanes );
+  return map;
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,715 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/contraction_hierarchy.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#include <fstream>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <memory>
+#include <mutex>
+
+#include "adore_map/parallel.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+namespace
+{
+
+constexpr char     MAGIC[8]       = { 'A', 'D', 'O', 'R', 'E', 'C', 'H', 'Y' };
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t ENDIAN_MARKER  = 0x01020304;
+
+struct FileHeader
+{
+  char     magic[8];
+  uint32_t version;
+  uint32_t endian_marker;
+  uint32_t allow_reverse;
+  uint32_t reserved;
+  uint64_t node_count;
+  uint64_t upward_count;
+  uint64_t downward_count;
+};
+
+static_assert( sizeof( LaneID ) == sizeof( uint64_t ), "lane ids are stored as 64 bit values" );
+
+using QueueEntry = std::pair<double, NodeIndex>;
+using Queue      = std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>>;
+
+// Dijkstra labels, reset in constant time by bumping the generation
+struct Labels
+{
+  std::vector<double>               cost;
+  std::vector<NodeIndex>            previous;
+  std::vector<const HierarchyEdge*> via; // edge from or to the previous node
+  std::vector<uint32_t>             reached;
+  std::vector<uint32_t>             settled;
+  uint32_t                          generation = 0;
+
+  void
+  reset( size_t node_count )
+  {
+    if( cost.size() != node_count || generation == std::numeric_limits<uint32_t>::max() )
+    {
+      cost.assign( node_count, 0.0 );
+      previous.assign( node_count, NO_NODE );
+      via.assign( node_count, nullptr );
+      reached.assign( node_count, 0 );
+      settled.assign( node_count, 0 );
+      generation = 0;
+    }
+    ++generation;
+  }
+
+  bool
+  has_cost( NodeIndex node ) const
+  {
+    return reached[node] == generation;
+  }
+
+  bool
+  improves( NodeIndex node, double new_cost ) const
+  {
+    return !has_cost( node ) || new_cost < cost[node];
+  }
+};
+
+// Labels are reused by all queries on the same thread, one slot per search direction
+Labels&
+get_labels( size_t node_count, size_t slot )
+{
+  thread_local Labels labels[2];
+  labels[slot].reset( node_count );
+  return labels[slot];
+}
+
+// Edge of the graph during contraction, at most one per pair of nodes
+using Arc = HierarchyEdge;
+
+// Inserts an arc or lowers the weight of the existing one to the same node
+void
+add_arc( std::vector<Arc>& arcs, NodeIndex target, NodeIndex middle, double weight )
+{
+  for( auto& arc : arcs )
+  {
+    if( arc.target != target )
+      continue;
+    if( weight < arc.weight )
+    {
+      arc.weight = weight;
+      arc.middle = middle;
+    }
+    return;
+  }
+  arcs.push_back( { target, middle, weight } );
+}
+
+// Labels of a witness search, reset in constant time like Labels
+struct WitnessLabels
+{
+  std::vector<double>   cost;
+  std::vector<uint32_t> reached;
+  std::vector<uint32_t> settled;
+  std::vector<uint32_t> target; // generation in which the node is a neighbour behind the contracted one
+  uint32_t              generation = 0;
+
+  void
+  reset( size_t node_count )
+  {
+    if( cost.size() != node_count || generation == std::numeric_limits<uint32_t>::max() )
+    {
+      cost.assign( node_count, 0.0 );
+      reached.assign( node_count, 0 );
+      settled.assign( node_count, 0 );
+      target.assign( node_count, 0 );
+      generation = 0;
+    }
+    ++generation;
+  }
+};
+
+struct Shortcut
+{
+  NodeIndex from;
+  NodeIndex to;
+  double    weight;
+};
+
+enum NodeState : uint8_t
+{
+  REMAINING,
+  CONTRACTING,
+  CONTRACTED
+};
+
+// The remaining graph while nodes are being contracted
+class Contraction
+{
+public:
+
+  Contraction( const CompactRoadGraph& graph, const ContractionConfig& config_ ) :
+    config( config_ ),
+    outgoing( graph.node_count() ),
+    incoming( graph.node_count() ),
+    state( graph.node_count(), REMAINING ),
+    contracted_neighbors( graph.node_count(), 0 )
+  {
+    for( NodeIndex node = 0; node < graph.node_count(); ++node )
+    {
+      auto add = [&]( NodeIndex from, NodeIndex to, double weight ) {
+        if( from == to )
+          return;
+        add_arc( outgoing[from], to, NO_NODE, weight );
+        add_arc( incoming[to], from, NO_NODE, weight );
+      };
+      for( const auto& edge : graph.get_successors( node ) )
+      {
+        add( node, edge.target, edge.weight );
+        if( config.allow_reverse )
+          add( edge.target, node, edge.weight );
+      }
+    }
+  }
+
+  // Shortcuts needed to remove the node. Witness paths only use remaining nodes, so nodes contracted in the
+  // same batch cannot serve as witnesses for each other.
+  void
+  find_shortcuts( NodeIndex node, size_t settle_limit, std::vector<Shortcut>& shortcuts ) const
+  {
+    auto& labels = acquire_labels();
+    for( const auto& in_arc : incoming[node] )
+    {
+      const NodeIndex source   = in_arc.target;
+      double          max_cost = 0.0;
+      for( const auto& out_arc : outgoing[node] )
+      {
+        if( out_arc.target != source )
+          max_cost = std::max( max_cost, in_arc.weight + out_arc.weight );
+      }
+
+      // The search ends once all neighbours behind the node are settled, their costs cannot improve any more
+      labels.reset( outgoing.size() );
+      size_t open_targets = 0;
+      for( const auto& out_arc : outgoing[node] )
+      {
+        labels.target[out_arc.target] = labels.generation;
+        ++open_targets;
+      }
+
+      labels.cost[source]    = 0.0;
+      labels.reached[source] = labels.generation;
+      size_t settled_count   = 0;
+      Queue  pq;
+      pq.push( { 0.0, source } );
+      while( !pq.empty() && open_targets > 0 && pq.top().first <= max_cost && settled_count < settle_limit )
+      {
+        const NodeIndex current = pq.top().second;
+        pq.pop();
+        if( labels.settled[current] == labels.generation )
+          continue;
+        labels.settled[current] = labels.generation;
+        ++settled_count;
+        if( labels.target[current] == labels.generation )
+          --open_targets;
+
+        for( const auto& arc : outgoing[current] )
+        {
+          if( arc.target == node || state[arc.target] != REMAINING )
+            continue;
+          const double new_cost = labels.cost[current] + arc.weight;
+          if( new_cost > max_cost )
+            continue;
+          if( labels.reached[arc.target] != labels.generation || new_cost < labels.cost[arc.target] )
+          {
+            labels.cost[arc.target]    = new_cost;
+            labels.reached[arc.target] = labels.generation;
+            pq.push( { new_cost, arc.target } );
+          }
+        }
+      }
+
+      for( const auto& out_arc : outgoing[node] )
+      {
+        if( out_arc.target == source )
+          continue;
+        const double via_cost = in_arc.weight + out_arc.weight;
+        if( labels.reached[out_arc.target] != labels.generation || labels.cost[out_arc.target] > via_cost )
+          shortcuts.push_back( { source, out_arc.target, via_cost } );
+      }
+    }
+    release_labels( labels );
+  }
+
+  // Edge difference plus the number of contracted neighbours, which spreads contraction evenly over the graph
+  double
+  compute_priority( NodeIndex node ) const
+  {
+    std::vector<Shortcut> shortcuts;
+    find_shortcuts( node, config.priority_settle_limit, shortcuts );
+    return static_cast<double>( shortcuts.size() ) - static_cast<double>( outgoing[node].size() + incoming[node].size() )
+         + contracted_neighbors[node];
+  }
+
+  // Removes the node from the graph and adds its shortcuts, returns the neighbours it had
+  std::vector<NodeIndex>
+  contract( NodeIndex node, const std::vector<Shortcut>& shortcuts )
+  {
+    std::vector<NodeIndex> neighbors;
+    for( const auto& arc : outgoing[node] )
+    {
+      std::erase_if( incoming[arc.target], [node]( const Arc& other ) { return other.target == node; } );
+      neighbors.push_back( arc.target );
+    }
+    for( const auto& arc : incoming[node] )
+    {
+      std::erase_if( outgoing[arc.target], [node]( const Arc& other ) { return other.target == node; } );
+      neighbors.push_back( arc.target );
+    }
+    for( const auto& shortcut : shortcuts )
+    {
+      add_arc( outgoing[shortcut.from], shortcut.to, node, shortcut.weight );
+      add_arc( incoming[shortcut.to], shortcut.from, node, shortcut.weight );
+    }
+
+    std::sort( neighbors.begin(), neighbors.end() );
+    neighbors.erase( std::unique( neighbors.begin(), neighbors.end() ), neighbors.end() );
+    for( const auto neighbor : neighbors )
+      ++contracted_neighbors[neighbor];
+    return neighbors;
+  }
+
+  // Labels of witness searches, one set per concurrent search so the arrays are allocated once per thread
+  WitnessLabels&
+  acquire_labels() const
+  {
+    std::lock_guard<std::mutex> lock( pool_mutex );
+    if( free_labels.empty() )
+    {
+      label_pool.push_back( std::make_unique<WitnessLabels>() );
+      return *label_pool.back();
+    }
+    auto* labels = free_labels.back();
+    free_labels.pop_back();
+    return *labels;
+  }
+
+  void
+  release_labels( WitnessLabels& labels ) const
+  {
+    std::lock_guard<std::mutex> lock( pool_mutex );
+    free_labels.push_back( &labels );
+  }
+
+  const ContractionConfig&           config;
+  std::vector<std::vector<Arc>>      outgoing;
+  std::vector<std::vector<Arc>>      incoming; // target is the node the arc comes from
+  std::vector<uint8_t>               state;
+  std::vector<uint32_t>              contracted_neighbors;
+
+private:
+
+  mutable std::mutex                                  pool_mutex;
+  mutable std::vector<std::unique_ptr<WitnessLabels>> label_pool;
+  mutable std::vector<WitnessLabels*>                 free_labels;
+};
+
+void
+flatten( std::vector<std::vector<HierarchyEdge>>& lists, std::vector<uint32_t>& offsets, std::vector<HierarchyEdge>& edges )
+{
+  offsets.assign( lists.size() + 1, 0 );
+  for( size_t node = 0; node < lists.size(); ++node )
+    offsets[node + 1] = offsets[node] + static_cast<uint32_t>( lists[node].size() );
+  edges.clear();
+  edges.reserve( offsets.back() );
+  for( auto& list : lists )
+  {
+    std::sort( list.begin(), list.end(), []( const HierarchyEdge& a, const HierarchyEdge& b ) { return a.target < b.target; } );
+    edges.insert( edges.end(), list.begin(), list.end() );
+  }
+}
+
+template<typename T>
+void
+write_array( std::ofstream& file, const std::vector<T>& values )
+{
+  file.write( reinterpret_cast<const char*>( values.data() ), static_cast<std::streamsize>( values.size() * sizeof( T ) ) );
+}
+
+template<typename T>
+void
+read_array( std::ifstream& file, std::vector<T>& values, uint64_t count )
+{
+  values.resize( count );
+  file.read( reinterpret_cast<char*>( values.data() ), static_cast<std::streamsize>( count * sizeof( T ) ) );
+  if( !file )
+    throw std::runtime_error( "Contraction hierarchy: file is truncated" );
+}
+
+bool
+valid_edges( const std::vector<uint32_t>& offsets, const std::vector<HierarchyEdge>& edges, size_t node_count )
+{
+  if( offsets.front() != 0 || offsets.back() != edges.size() || !std::is_sorted( offsets.begin(), offsets.end() ) )
+    return false;
+  return std::all_of( edges.begin(), edges.end(), [&]( const HierarchyEdge& edge ) {
+    return edge.target < node_count && ( edge.middle == NO_NODE || edge.middle < node_count );
+  } );
+}
+
+} // namespace
+
+ContractionHierarchy
+ContractionHierarchy::build( const CompactRoadGraph& graph, const ContractionConfig& config, const ContractionHierarchy* previous )
+{
+  const size_t node_count = graph.node_count();
+  Contraction  contraction( graph, config );
+
+  // Nodes are contracted in ascending (key, node) order among their neighbours
+  std::vector<double> keys( node_count, 0.0 );
+  if( previous )
+  {
+    for( NodeIndex node = 0; node < node_count; ++node )
+    {
+      const NodeIndex old_node = previous->find_node( graph.get_lane_id( node ) );
+      keys[node]               = old_node != NO_NODE ? previous->ranks[old_node] : static_cast<double>( previous->node_count() + node );
+    }
+  }
+  else
+  {
+    parallel_for( node_count, config.thread_count, [&]( size_t node ) { keys[node] = contraction.compute_priority( node ); } );
+  }
+
+  auto before = [&]( NodeIndex a, NodeIndex b ) { return std::tie( keys[a], a ) < std::tie( keys[b], b ); };
+
+  ContractionHierarchy hierarchy;
+  hierarchy.allow_reverse = config.allow_reverse;
+  hierarchy.ranks.assign( node_count, 0 );
+  for( NodeIndex node = 0; node < node_count; ++node )
+    hierarchy.lane_ids.push_back( graph.get_lane_id( node ) );
+
+  // Every edge of the hierarchy leads from a node to one that came before it among its neighbours, so a
+  // fixed order can be kept as is even though batches contract its nodes out of sequence
+  uint32_t next_rank = 0;
+  if( previous )
+  {
+    std::vector<NodeIndex> order( node_count );
+    for( NodeIndex node = 0; node < node_count; ++node )
+      order[node] = node;
+    std::sort( order.begin(), order.end(), before );
+    for( const auto node : order )
+      hierarchy.ranks[node] = next_rank++;
+  }
+
+  std::vector<std::vector<HierarchyEdge>> upward( node_count );
+  std::vector<std::vector<HierarchyEdge>> downward( node_count );
+
+  std::vector<NodeIndex> remaining( node_count );
+  for( NodeIndex node = 0; node < node_count; ++node )
+    remaining[node] = node;
+
+  while( !remaining.empty() )
+  {
+    // Nodes that come before all their remaining neighbours are pairwise independent
+    std::vector<uint8_t> selected( remaining.size(), 0 );
+    parallel_for( remaining.size(), config.thread_count, [&]( size_t i ) {
+      const NodeIndex node  = remaining[i];
+      auto            first = [&]( const std::vector<Arc>& arcs ) {
+        return std::all_of( arcs.begin(), arcs.end(), [&]( const Arc& arc ) { return before( node, arc.target ); } );
+      };
+      selected[i] = first( contraction.outgoing[node] ) && first( contraction.incoming[node] );
+    } );
+
+    std::vector<NodeIndex> batch;
+    for( size_t i = 0; i < remaining.size(); ++i )
+    {
+      if( selected[i] )
+        batch.push_back( remaining[i] );
+    }
+    for( const auto node : batch )
+      contraction.state[node] = CONTRACTING;
+
+    std::vector<std::vector<Shortcut>> shortcuts( batch.size() );
+    parallel_for( batch.size(), config.thread_count, [&]( size_t i ) { contraction.find_shortcuts( batch[i], config.witness_settle_limit, shortcuts[i] ); } );
+
+    std::vector<NodeIndex> touched;
+    for( size_t i = 0; i < batch.size(); ++i )
+    {
+      const NodeIndex node = batch[i];
+      if( !previous )
+        hierarchy.ranks[node] = next_rank++;
+      upward[node]          = contraction.outgoing[node];
+      downward[node]        = contraction.incoming[node];
+      const auto neighbors  = contraction.contract( node, shortcuts[i] );
+      touched.insert( touched.end(), neighbors.begin(), neighbors.end() );
+      contraction.state[node] = CONTRACTED;
+    }
+
+    std::erase_if( remaining, [&]( NodeIndex node ) { return contraction.state[node] == CONTRACTED; } );
+
+    // Contraction changes the priorities of the neighbours, a fixed order stays as it is
+    if( !previous )
+    {
+      std::sort( touched.begin(), touched.end() );
+      touched.erase( std::unique( touched.begin(), touched.end() ), touched.end() );
+      parallel_for( touched.size(), config.thread_count,
+                    [&]( size_t i ) { keys[touched[i]] = contraction.compute_priority( touched[i] ); } );
+    }
+  }
+
+  flatten( upward, hierarchy.upward_offsets, hierarchy.upward_edges );
+  flatten( downward, hierarchy.downward_offsets, hierarchy.downward_edges );
+  return hierarchy;
+}
+
+std::deque<LaneID>
+ContractionHierarchy::find_path( LaneID from, LaneID to ) const
+{
+  if( from == to )
+    return { from };
+
+  const NodeIndex source = find_node( from );
+  const NodeIndex target = find_node( to );
+  if( source == NO_NODE || target == NO_NODE )
+    return {};
+
+  Labels* labels[2] = { &get_labels( node_count(), 0 ), &get_labels( node_count(), 1 ) };
+  Queue   queues[2];
+  for( const size_t side : { 0, 1 } )
+  {
+    const NodeIndex start         = side == 0 ? source : target;
+    labels[side]->cost[start]     = 0.0;
+    labels[side]->previous[start] = NO_NODE;
+    labels[side]->reached[start]  = labels[side]->generation;
+    queues[side].push( { 0.0, start } );
+  }
+
+  double    best_cost = std::numeric_limits<double>::infinity();
+  NodeIndex meeting   = NO_NODE;
+
+  // Both sides climb to more important nodes until neither can improve on the best meeting point
+  auto active = [&]( size_t side ) { return !queues[side].empty() && queues[side].top().first < best_cost; };
+  while( active( 0 ) || active( 1 ) )
+  {
+    const size_t side = !active( 1 ) || ( active( 0 ) && queues[0].top().first <= queues[1].top().first ) ? 0 : 1;
+    auto&        own  = *labels[side];
+    const auto   current = queues[side].top().second;
+    queues[side].pop();
+    if( own.settled[current] == own.generation )
+      continue;
+    own.settled[current] = own.generation;
+
+    const auto& other = *labels[1 - side];
+    if( other.has_cost( current ) && own.cost[current] + other.cost[current] < best_cost )
+    {
+      best_cost = own.cost[current] + other.cost[current];
+      meeting   = current;
+    }
+
+    // Stall the node if a more important one reaches it cheaper, its shortest path then leads downwards
+    const auto stall_edges = side == 0 ? get_downward( current ) : get_upward( current );
+    const bool stalled     = std::any_of( stall_edges.begin(), stall_edges.end(), [&]( const HierarchyEdge& edge ) {
+      return own.has_cost( edge.target ) && own.cost[edge.target] + edge.weight < own.cost[current];
+    } );
+    if( stalled )
+      continue;
+
+    for( const auto& edge : side == 0 ? get_upward( current ) : get_downward( current ) )
+    {
+      const double new_cost = own.cost[current] + edge.weight;
+      if( own.improves( edge.target, new_cost ) )
+      {
+        own.cost[edge.target]     = new_cost;
+        own.previous[edge.target] = current;
+        own.via[edge.target]      = &edge;
+        own.reached[edge.target]  = own.generation;
+        queues[side].push( { new_cost, edge.target } );
+      }
+    }
+  }
+
+  if( meeting == NO_NODE )
+    return {};
+
+  // Hops of the path from source to target, each an edge of the hierarchy
+  std::vector<std::tuple<NodeIndex, NodeIndex, NodeIndex>> hops; // from, to, middle
+  for( NodeIndex node = meeting; labels[0]->previous[node] != NO_NODE; node = labels[0]->previous[node] )
+    hops.emplace_back( labels[0]->previous[node], node, labels[0]->via[node]->middle );
+  std::reverse( hops.begin(), hops.end() );
+  for( NodeIndex node = meeting; labels[1]->previous[node] != NO_NODE; node = labels[1]->previous[node] )
+    hops.emplace_back( node, labels[1]->previous[node], labels[1]->via[node]->middle );
+
+  std::deque<LaneID> path{ from };
+  for( const auto& [hop_from, hop_to, middle] : hops )
+    unpack( hop_from, hop_to, middle, path );
+  return path;
+}
+
+void
+ContractionHierarchy::unpack( NodeIndex from, NodeIndex to, NodeIndex middle, std::deque<LaneID>& path ) const
+{
+  auto find_edge = []( std::span<const HierarchyEdge> edges, NodeIndex target ) {
+    return std::lower_bound( edges.begin(), edges.end(), target,
+                             []( const HierarchyEdge& edge, NodeIndex node ) { return edge.target < node; } );
+  };
+
+  // Shortcuts are replaced by their two halves until only connections are left, first half on top
+  std::vector<std::tuple<NodeIndex, NodeIndex, NodeIndex>> stack{ { from, to, middle } };
+  while( !stack.empty() )
+  {
+    const auto [hop_from, hop_to, hop_middle] = stack.back();
+    stack.pop_back();
+    if( hop_middle == NO_NODE )
+    {
+      path.push_back( lane_ids[hop_to] );
+      continue;
+    }
+
+    // The bypassed node is less important than both ends, so both halves are stored at it
+    const auto downward = get_downward( hop_middle );
+    const auto upward   = get_upward( hop_middle );
+    const auto first    = find_edge( downward, hop_from );
+    const auto second   = find_edge( upward, hop_to );
+    if( first == downward.end() || first->target != hop_from || second == upward.end() || second->target != hop_to )
+      throw std::runtime_error( "Contraction hierarchy: shortcut half missing" );
+    stack.emplace_back( hop_middle, hop_to, second->middle );
+    stack.emplace_back( hop_from, hop_middle, first->middle );
+  }
+}
+
+std::vector<LaneID>
+ContractionHierarchy::get_order() const
+{
+  std::vector<LaneID> order( lane_ids.size() );
+  for( size_t node = 0; node < lane_ids.size(); ++node )
+    order[ranks[node]] = lane_ids[node];
+  return order;
+}
+
+void
+ContractionHierarchy::write( const std::string& file_location ) const
+{
+  FileHeader header{};
+  std::memcpy( header.magic, MAGIC, sizeof( MAGIC ) );
+  header.version        = FORMAT_VERSION;
+  header.endian_marker  = ENDIAN_MARKER;
+  header.allow_reverse  = allow_reverse;
+  header.node_count     = lane_ids.size();
+  header.upward_count   = upward_edges.size();
+  header.downward_count = downward_edges.size();
+
+  // Written next to the target and renamed over it, so readers never see a partly written file
+  const std::string temporary_location = file_location + ".tmp";
+  std::ofstream     file( temporary_location, std::ios::binary | std::ios::trunc );
+  if( !file )
+    throw std::runtime_error( "Failed to open contraction hierarchy file for writing: " + temporary_location );
+
+  file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+  write_array( file, lane_ids );
+  write_array( file, ranks );
+  write_array( file, upward_offsets );
+  write_array( file, upward_edges );
+  write_array( file, downward_offsets );
+  write_array( file, downward_edges );
+  file.close();
+  if( !file || std::rename( temporary_location.c_str(), file_location.c_str() ) != 0 )
+  {
+    std::remove( temporary_location.c_str() );
+    throw std::runtime_error( "Failed to write contraction hierarchy file: " + file_location );
+  }
+}
+
+ContractionHierarchy
+ContractionHierarchy::read( const std::string& file_location )
+{
+  std::ifstream file( file_location, std::ios::binary );
+  if( !file )
+    throw std::runtime_error( "Failed to open contraction hierarchy file: " + file_location );
+
+  FileHeader header{};
+  file.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+  if( !file || std::memcmp( header.magic, MAGIC, sizeof( MAGIC ) ) != 0 )
+    throw std::runtime_error( "Contraction hierarchy: not a contraction hierarchy file (bad magic)" );
+  if( header.endian_marker != ENDIAN_MARKER )
+    throw std::runtime_error( "Contraction hierarchy: written with a different byte order" );
+  if( header.version != FORMAT_VERSION )
+    throw std::runtime_error( "Contraction hierarchy: unsupported format version " + std::to_string( header.version ) );
+  if( header.node_count >= NO_NODE )
+    throw std::runtime_error( "Contraction hierarchy: too many nodes" );
+
+  ContractionHierarchy hierarchy;
+  hierarchy.allow_reverse = header.allow_reverse != 0;
+  read_array( file, hierarchy.lane_ids, header.node_count );
+  read_array( file, hierarchy.ranks, header.node_count );
+  read_array( file, hierarchy.upward_offsets, header.node_count + 1 );
+  read_array( file, hierarchy.upward_edges, header.upward_count );
+  read_array( file, hierarchy.downward_offsets, header.node_count + 1 );
+  read_array( file, hierarchy.downward_edges, header.downward_count );
+
+  const size_t node_count = hierarchy.lane_ids.size();
+  if( std::adjacent_find( hierarchy.lane_ids.begin(), hierarchy.lane_ids.end(), std::greater_equal<>() ) != hierarchy.lane_ids.end()
+      || std::any_of( hierarchy.ranks.begin(), hierarchy.ranks.end(), [&]( uint32_t rank ) { return rank >= node_count; } )
+      || !valid_edges( hierarchy.upward_offsets, hierarchy.upward_edges, node_count )
+      || !valid_edges( hierarchy.downward_offsets, hierarchy.downward_edges, node_count ) )
+    throw std::runtime_error( "Contraction hierarchy: inconsistent data" );
+
+  // Every rank is used once, edges lead to more important nodes and shortcuts bypass a less important
+  // node holding both halves, so queries only climb and unpacking ends
+  std::vector<bool> rank_used( node_count, false );
+  for( const auto rank : hierarchy.ranks )
+  {
+    if( rank_used[rank] )
+      throw std::runtime_error( "Contraction hierarchy: ranks are not a permutation" );
+    rank_used[rank] = true;
+  }
+
+  auto has_edge = []( std::span<const HierarchyEdge> edges, NodeIndex target ) {
+    auto it = std::lower_bound( edges.begin(), edges.end(), target,
+                                []( const HierarchyEdge& edge, NodeIndex node ) { return edge.target < node; } );
+    return it != edges.end() && it->target == target;
+  };
+  auto valid_node = [&]( NodeIndex node, std::span<const HierarchyEdge> edges, bool upward ) {
+    auto by_target = []( const HierarchyEdge& a, const HierarchyEdge& b ) { return a.target < b.target; };
+    if( !std::is_sorted( edges.begin(), edges.end(), by_target ) )
+      return false;
+    return std::all_of( edges.begin(), edges.end(), [&]( const HierarchyEdge& edge ) {
+      if( hierarchy.ranks[edge.target] <= hierarchy.ranks[node] )
+        return false;
+      if( edge.middle == NO_NODE )
+        return true;
+
+      // Halves from -> middle and middle -> to, with from and to swapped for downward edges
+      const NodeIndex from = upward ? node : edge.target;
+      const NodeIndex to   = upward ? edge.target : node;
+      return hierarchy.ranks[edge.middle] < hierarchy.ranks[node] && has_edge( hierarchy.get_downward( edge.middle ), from )
+          && has_edge( hierarchy.get_upward( edge.middle ), to );
+    } );
+  };
+  for( NodeIndex node = 0; node < node_count; ++node )
+  {
+    if( !valid_node( node, hierarchy.get_upward( node ), true ) || !valid_node( node, hierarchy.get_downward( node ), false ) )
+      throw std::runtime_error( "Contraction hierarchy: edges or shortcuts do not follow the ranks" );
+  }
+
+  return hierarchy;
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,217 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/distance_field.hpp"
+
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+namespace adore
+{
+namespace map
+{
+
+namespace
+{
+
+constexpr double INF = 1e20;
+
+// Squared Euclidean distance transform of one line (Felzenszwalb and Huttenlocher), in place.
+// values holds 0 at feature cells and INF elsewhere.
+// OpenCV is found for its headers only, the library does not link any OpenCV module. cv::distanceTransform
+// would add opencv_imgproc to the link and a copy of every padded tile window into 8 bit and float images.
+// Two passes of this function give the same exact distances directly on the raster cells.
+void
+distance_transform_1d( std::vector<double>& values, std::vector<double>& result, std::vector<size_t>& hull,
+                       std::vector<double>& boundaries )
+{
+  const size_t n = values.size();
+  result.resize( n );
+  hull.resize( n );
+  boundaries.resize( n + 1 );
+
+  // Lower envelope of the parabolas rooted at every cell
+  auto intersection = [&]( size_t q, size_t p ) {
+    return ( ( values[q] + static_cast<double>( q * q ) ) - ( values[p] + static_cast<double>( p * p ) ) ) / ( 2.0 * ( q - p ) );
+  };
+
+  size_t k      = 0;
+  hull[0]       = 0;
+  boundaries[0] = -INF;
+  boundaries[1] = INF;
+  for( size_t q = 1; q < n; ++q )
+  {
+    double s = intersection( q, hull[k] );
+    while( s <= boundaries[k] )
+    {
+      --k;
+      s = intersection( q, hull[k] );
+    }
+    ++k;
+    hull[k]           = q;
+    boundaries[k]     = s;
+    boundaries[k + 1] = INF;
+  }
+
+  k = 0;
+  for( size_t q = 0; q < n; ++q )
+  {
+    while( boundaries[k + 1] < static_cast<double>( q ) )
+      ++k;
+    const double offset = static_cast<double>( q ) - static_cast<double>( hull[k] );
+    result[q]           = offset * offset + values[hull[k]];
+  }
+  values.swap( result );
+}
+
+// Squared distance in cells from every cell to the nearest cell where feature is true
+std::vector<double>
+distance_transform( const std::vector<bool>& feature, size_t size )
+{
+  std::vector<double> grid( size * size );
+  for( size_t i = 0; i < grid.size(); ++i )
+    grid[i] = feature[i] ? 0.0 : INF;
+
+  std::vector<double> line( size ), result;
+  std::vector<size_t> hull;
+  std::vector<double> boundaries;
+  for( size_t row = 0; row < size; ++row )
+  {
+    std::copy( grid.begin() + row * size, grid.begin() + ( row + 1 ) * size, line.begin() );
+    distance_transform_1d( line, result, hull, boundaries );
+    std::copy( line.begin(), line.end(), grid.begin() + row * size );
+  }
+  for( size_t column = 0; column < size; ++column )
+  {
+    for( size_t row = 0; row < size; ++row )
+      line[row] = grid[row * size + column];
+    distance_transform_1d( line, result, hull, boundaries );
+    for( size_t row = 0; row < size; ++row )
+      grid[row * size + column] = line[row];
+  }
+  return grid;
+}
+
+} // namespace
+
+DistanceField::DistanceField( std::shared_ptr<const MapRaster> raster_, double max_distance_ ) :
+  raster( std::move( raster_ ) ),
+  max_distance( max_distance_ )
+{
+  if( !raster )
+    throw std::invalid_argument( "DistanceField: raster is required" );
+  if( !( max_distance > 0.0 ) )
+    throw std::invalid_argument( "DistanceField: max distance must be positive" );
+  resolution = raster->get_config().resolution;
+}
+
+DistanceSample
+DistanceField::sample( double x, double y ) const
+{
+  const auto   tile = get_tile( raster->get_key( x, y ) );
+  const double fx   = ( x - tile->x_min ) / resolution;
+  const double fy   = ( y - tile->y_min ) / resolution;
+  const size_t ix   = std::min( static_cast<size_t>( std::max( fx, 0.0 ) ), tile->size - 2 );
+  const size_t iy   = std::min( static_cast<size_t>( std::max( fy, 0.0 ) ), tile->size - 2 );
+  const double tx   = fx - ix;
+  const double ty   = fy - iy;
+
+  const double v00 = tile->distances[iy * tile->size + ix];
+  const double v10 = tile->distances[iy * tile->size + ix + 1];
+  const double v01 = tile->distances[( iy + 1 ) * tile->size + ix];
+  const double v11 = tile->distances[( iy + 1 ) * tile->size + ix + 1];
+
+  DistanceSample result;
+  result.distance = ( 1.0 - ty ) * ( ( 1.0 - tx ) * v00 + tx * v10 ) + ty * ( ( 1.0 - tx ) * v01 + tx * v11 );
+  result.dx       = ( ( 1.0 - ty ) * ( v10 - v00 ) + ty * ( v11 - v01 ) ) / resolution;
+  result.dy       = ( ( 1.0 - tx ) * ( v01 - v00 ) + tx * ( v11 - v10 ) ) / resolution;
+  return result;
+}
+
+std::shared_ptr<const DistanceTile>
+DistanceField::get_tile( const TileKey& key ) const
+{
+  {
+    std::shared_lock lock( mutex );
+    auto             it = tiles.find( key );
+    if( it != tiles.end() )
+      return it->second;
+  }
+
+  // Compute outside the lock, a tile computed twice by racing threads is identical
+  auto             tile = compute_tile( key );
+  std::unique_lock lock( mutex );
+  return tiles.emplace( key, std::move( tile ) ).first->second;
+}
+
+size_t
+DistanceField::cached_tiles() const
+{
+  std::shared_lock lock( mutex );
+  return tiles.size();
+}
+
+std::shared_ptr<const DistanceTile>
+DistanceField::compute_tile( const TileKey& key ) const
+{
+  // Raster cell centers lie on a global grid at (n + 0.5) * resolution
+  const auto    cells    = static_cast<int64_t>( std::llround( raster->get_tile_size() / resolution ) );
+  const auto    padding  = static_cast<int64_t>( std::ceil( max_distance / resolution ) ) + 1;
+  const int64_t first_ix = key.ix * cells - 1;
+  const int64_t first_iy = key.iy * cells - 1;
+
+  auto tile   = std::make_shared<DistanceTile>();
+  tile->key   = key;
+  tile->size  = static_cast<size_t>( cells + 2 );
+  tile->x_min = ( first_ix + 0.5 ) * resolution;
+  tile->y_min = ( first_iy + 0.5 ) * resolution;
+
+  // Occupancy of the tile samples and everything within max_distance around them
+  const size_t      size = tile->size + 2 * padding;
+  std::vector<bool> inside( size * size ), outside( size * size );
+  for( size_t row = 0; row < size; ++row )
+  {
+    const double y = ( first_iy - padding + static_cast<int64_t>( row ) + 0.5 ) * resolution;
+    for( size_t column = 0; column < size; ++column )
+    {
+      const double x               = ( first_ix - padding + static_cast<int64_t>( column ) + 0.5 ) * resolution;
+      const bool   drivable        = raster->is_drivable( x, y );
+      inside[row * size + column]  = drivable;
+      outside[row * size + column] = !drivable;
+    }
+  }
+
+  const auto to_outside = distance_transform( outside, size );
+  const auto to_inside  = distance_transform( inside, size );
+
+  // The edge lies half a cell from the centers of the cells on either side of it
+  tile->distances.resize( tile->size * tile->size );
+  for( size_t row = 0; row < tile->size; ++row )
+  {
+    for( size_t column = 0; column < tile->size; ++column )
+    {
+      const size_t cell     = ( row + padding ) * size + column + padding;
+      const double distance = inside[cell] ? std::sqrt( to_outside[cell] ) * resolution - 0.5 * resolution
+                                           : 0.5 * resolution - std::sqrt( to_inside[cell] ) * resolution;
+      tile->distances[row * tile->size + column] = static_cast<float>( std::clamp( distance, -max_distance, max_distance ) );
+    }
+  }
+  return tile;
+}
+
+} // namespace map
+} // namespace adore
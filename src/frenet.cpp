@@ -0,0 +1,216 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/frenet.hpp"
+
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
+
+namespace adore
+{
+namespace map
+{
+
+namespace
+{
+
+constexpr size_t MAX_NEWTON_ITERATIONS = 20;
+constexpr double MAX_NEWTON_STEP       = 2.0; // [m], keeps the refinement near the initial guess
+constexpr double S_TOLERANCE           = 1e-9;
+constexpr double LINE_SEARCH_THRESHOLD = 1e-4;
+
+CenterLineSample
+evaluate_center_polyline( const std::vector<MapPoint>& points, double s )
+{
+  CenterLineSample sample;
+  if( points.empty() )
+    return sample;
+  if( points.size() == 1 )
+  {
+    sample.x = points.front().x;
+    sample.y = points.front().y;
+    return sample;
+  }
+
+  auto it = std::upper_bound( points.begin(), points.end(), s, []( double value, const MapPoint& p ) { return value < p.s; } );
+  const size_t i = std::clamp<size_t>( static_cast<size_t>( it - points.begin() ), 1, points.size() - 1 );
+
+  const auto&  a  = points[i - 1];
+  const auto&  b  = points[i];
+  const double ds = b.s - a.s;
+  if( ds <= 0.0 )
+  {
+    sample.x = a.x;
+    sample.y = a.y;
+    return sample;
+  }
+
+  const double t = ( s - a.s ) / ds;
+  sample.x       = a.x + t * ( b.x - a.x );
+  sample.y       = a.y + t * ( b.y - a.y );
+  sample.dx      = ( b.x - a.x ) / ds;
+  sample.dy      = ( b.y - a.y ) / ds;
+  return sample;
+}
+
+// Newton iterations on the squared distance, falling back to a Gauss-Newton step where it is not convex.
+// Larger steps that do not get closer are halved, the borders can have corners where plain Newton oscillates.
+double
+refine_projection( const Lane& lane, double x, double y, double s, double s_min, double s_max )
+{
+  auto c       = evaluate_center_line( lane, s );
+  auto dist_sq = ( c.x - x ) * ( c.x - x ) + ( c.y - y ) * ( c.y - y );
+  for( size_t iteration = 0; iteration < MAX_NEWTON_ITERATIONS; ++iteration )
+  {
+    const double ex       = c.x - x;
+    const double ey       = c.y - y;
+    const double gradient = ex * c.dx + ey * c.dy;
+    const double speed_sq = c.dx * c.dx + c.dy * c.dy;
+    double       hessian  = speed_sq + ex * c.ddx + ey * c.ddy;
+    if( hessian <= 1e-9 )
+      hessian = speed_sq;
+    if( hessian <= 1e-12 )
+      break;
+
+    double step     = std::clamp( -gradient / hessian, -MAX_NEWTON_STEP, MAX_NEWTON_STEP );
+    bool   improved = false;
+    while( std::fabs( step ) >= S_TOLERANCE )
+    {
+      const double new_s       = std::clamp( s + step, s_min, s_max );
+      const auto   candidate   = evaluate_center_line( lane, new_s );
+      const double new_dist_sq = ( candidate.x - x ) * ( candidate.x - x ) + ( candidate.y - y ) * ( candidate.y - y );
+      // Coordinates are large (UTM), so tiny final steps are taken without comparing distances
+      if( new_dist_sq <= dist_sq || std::fabs( step ) < LINE_SEARCH_THRESHOLD )
+      {
+        improved = std::fabs( new_s - s ) >= S_TOLERANCE;
+        s        = new_s;
+        c        = candidate;
+        dist_sq  = new_dist_sq;
+        break;
+      }
+      step *= 0.5;
+    }
+    if( !improved )
+      break;
+  }
+  return s;
+}
+
+} // namespace
+
+CenterLineSample
+evaluate_center_line( const Lane& lane, double s )
+{
+  const auto& points = lane.borders.center.interpolated_points;
+  const auto& inner  = lane.borders.inner.spline;
+  const auto& outer  = lane.borders.outer.spline;
+  if( !inner || !outer || points.size() < 2 || points.back().s <= 0.0 )
+    return evaluate_center_polyline( points, s );
+
+  // Center point i lies at s_i = t_i * S and averages the borders at t_i * L_inner and t_i * L_outer
+  const double center_length = points.back().s;
+  const double t             = std::clamp( s / center_length, 0.0, 1.0 );
+  const double inner_scale   = inner->get_total_length() / center_length;
+  const double outer_scale   = outer->get_total_length() / center_length;
+  const double inner_s       = t * inner->get_total_length();
+  const double outer_s       = t * outer->get_total_length();
+
+  const MapPoint inner_point = inner->get_point_at_s( inner_s );
+  const MapPoint outer_point = outer->get_point_at_s( outer_s );
+
+  CenterLineSample sample;
+  sample.x   = 0.5 * ( inner_point.x + outer_point.x );
+  sample.y   = 0.5 * ( inner_point.y + outer_point.y );
+  sample.dx  = 0.5 * ( inner->get_x_derivative_at_s( inner_s ) * inner_scale + outer->get_x_derivative_at_s( outer_s ) * outer_scale );
+  sample.dy  = 0.5 * ( inner->get_y_derivative_at_s( inner_s ) * inner_scale + outer->get_y_derivative_at_s( outer_s ) * outer_scale );
+  sample.ddx = 0.5
+             * ( inner->get_x_second_derivative_at_s( inner_s ) * inner_scale * inner_scale
+                 + outer->get_x_second_derivative_at_s( outer_s ) * outer_scale * outer_scale );
+  sample.ddy = 0.5
+             * ( inner->get_y_second_derivative_at_s( inner_s ) * inner_scale * inner_scale
+                 + outer->get_y_second_derivative_at_s( outer_s ) * outer_scale * outer_scale );
+  return sample;
+}
+
+FrenetCoordinate
+project_onto_lane( const Lane& lane, double x, double y, double s_guess )
+{
+  FrenetCoordinate frenet;
+  frenet.lane_id = lane.id;
+
+  const auto& points = lane.borders.center.interpolated_points;
+  if( points.empty() )
+    return frenet;
+
+  const double s_min = points.front().s;
+  const double s_max = points.back().s;
+  s_guess            = std::clamp( s_guess, s_min, s_max );
+
+  // The borders can have corners between samples, so also start from the neighbouring center samples
+  // and keep the closest local minimum
+  auto next = std::upper_bound( points.begin(), points.end(), s_guess, []( double value, const MapPoint& p ) { return value < p.s; } );
+  auto prev = next == points.begin() ? next : std::prev( next );
+  if( prev != points.begin() && prev->s == s_guess )
+    --prev;
+
+  double best_s         = s_guess;
+  double best_dist      = std::numeric_limits<double>::max();
+  auto   try_projection = [&]( double start ) {
+    const double s    = refine_projection( lane, x, y, start, s_min, s_max );
+    const auto   c    = evaluate_center_line( lane, s );
+    const double dist = std::hypot( x - c.x, y - c.y );
+    if( dist < best_dist )
+    {
+      best_dist = dist;
+      best_s    = s;
+    }
+  };
+  try_projection( s_guess );
+  try_projection( prev->s );
+  if( next != points.end() )
+    try_projection( next->s );
+
+  // The offset is perpendicular at an interior minimum, at the clamped ends it is the distance to the end point
+  const auto   c     = evaluate_center_line( lane, best_s );
+  const double cross = c.dx * ( y - c.y ) - c.dy * ( x - c.x );
+  frenet.s           = best_s;
+  frenet.d           = std::copysign( best_dist, cross );
+  return frenet;
+}
+
+math::Pose2d
+lane_frenet_to_pose( const Lane& lane, double s, double d )
+{
+  math::Pose2d pose;
+
+  const auto& points = lane.borders.center.interpolated_points;
+  if( points.empty() )
+    return pose;
+
+  const auto   c    = evaluate_center_line( lane, std::clamp( s, points.front().s, points.back().s ) );
+  const double norm = std::hypot( c.dx, c.dy );
+  pose.x            = c.x;
+  pose.y            = c.y;
+  if( norm < 1e-12 )
+    return pose;
+
+  pose.x   -= d * c.dy / norm;
+  pose.y   += d * c.dx / norm;
+  pose.yaw  = std::atan2( c.dy, c.dx );
+  return pose;
+}
+
+} // namespace map
+} // namespace adore
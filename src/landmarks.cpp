@@ -0,0 +1,142 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/landmarks.hpp"
+
+#include <cmath>
+
+#include <limits>
+
+#include "adore_map/compact_road_graph.hpp"
+#include "adore_map/parallel.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+namespace
+{
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+
+} // namespace
+
+LandmarkIndex
+LandmarkIndex::build( const CompactRoadGraph& graph, const LandmarkConfig& config )
+{
+  LandmarkIndex index;
+  const size_t  node_count = graph.node_count();
+  for( NodeIndex node = 0; node < node_count; ++node )
+    index.lane_ids.push_back( graph.get_lane_id( node ) );
+
+  // Farthest point selection with connections usable both ways: each landmark is the node farthest from
+  // all landmarks so far, nodes no landmark reaches (other components) first
+  std::vector<NodeIndex> landmark_nodes;
+  std::vector<double>    nearest( node_count, INF );
+  NodeIndex              next = 0;
+  if( node_count > 0 )
+  {
+    const auto from_first = graph.shortest_costs( 0, true, true );
+    for( NodeIndex node = 0; node < node_count; ++node )
+    {
+      if( from_first[node] > from_first[next] )
+        next = node;
+    }
+  }
+  while( landmark_nodes.size() < std::min( config.landmark_count, node_count ) )
+  {
+    landmark_nodes.push_back( next );
+    const auto costs = graph.shortest_costs( next, true, true );
+    for( NodeIndex node = 0; node < node_count; ++node )
+      nearest[node] = std::min( nearest[node], costs[node] );
+    next = static_cast<NodeIndex>( std::max_element( nearest.begin(), nearest.end() ) - nearest.begin() );
+    if( nearest[next] <= 0.0 )
+      break; // every node is a landmark
+  }
+
+  const size_t count = landmark_nodes.size();
+  for( const auto node : landmark_nodes )
+    index.landmarks.push_back( graph.get_lane_id( node ) );
+  index.from_landmark.assign( node_count * count, 0.0f );
+  index.to_landmark.assign( node_count * count, 0.0f );
+  index.either_way.assign( node_count * count, 0.0f );
+
+  // One search per landmark and table, each writes its own column
+  std::vector<double> max_cost( 3 * count, 0.0 );
+  parallel_for( 3 * count, config.thread_count, [&]( size_t task ) {
+    const size_t k     = task % count;
+    const size_t table = task / count;
+    const auto   costs = graph.shortest_costs( landmark_nodes[k], table != 1, table != 0 );
+    auto&        out   = table == 0 ? index.from_landmark : table == 1 ? index.to_landmark : index.either_way;
+    for( size_t row = 0; row < node_count; ++row )
+    {
+      out[row * count + k] = static_cast<float>( costs[row] );
+      if( std::isfinite( costs[row] ) )
+        max_cost[task] = std::max( max_cost[task], costs[row] );
+    }
+  } );
+
+  // Rounding a cost to the nearest float moves it by at most half an ulp, 2^-24 of the cost, so a difference
+  // of two rounded costs is off by at most 2^-23 of the largest. The tolerance is twice that, 2^-22, which
+  // also covers the double rounding of the path sums the bounds are compared against.
+  index.tolerance.assign( count, 0.0 );
+  for( size_t k = 0; k < count; ++k )
+    index.tolerance[k] = std::ldexp( std::max( { max_cost[k], max_cost[count + k], max_cost[2 * count + k] } ), -22 );
+  return index;
+}
+
+double
+LandmarkIndex::lower_bound( uint32_t from, uint32_t to, bool allow_reverse ) const
+{
+  if( from == NO_ROW || to == NO_ROW )
+    return 0.0;
+
+  const size_t count = landmarks.size();
+  double       bound = 0.0;
+  for( size_t k = 0; k < count; ++k )
+  {
+    double difference = 0.0;
+    if( allow_reverse )
+    {
+      const double at_from = either_way[from * count + k];
+      const double at_to   = either_way[to * count + k];
+      // Both ways, a landmark that reaches only one of the two nodes separates them
+      if( std::isinf( at_from ) != std::isinf( at_to ) )
+        return INF;
+      if( std::isinf( at_from ) )
+        continue;
+      difference = std::abs( at_to - at_from );
+    }
+    else
+    {
+      const double landmark_from = from_landmark[from * count + k];
+      const double landmark_to   = from_landmark[to * count + k];
+      const double from_to_lm    = to_landmark[from * count + k];
+      const double to_to_lm      = to_landmark[to * count + k];
+      // The goal is unreachable if the landmark reaches the start but not the goal, or the goal reaches the
+      // landmark but the start does not
+      if( ( std::isfinite( landmark_from ) && std::isinf( landmark_to ) ) || ( std::isinf( from_to_lm ) && std::isfinite( to_to_lm ) ) )
+        return INF;
+      if( std::isfinite( landmark_from ) && std::isfinite( landmark_to ) )
+        difference = std::max( difference, landmark_to - landmark_from );
+      if( std::isfinite( from_to_lm ) && std::isfinite( to_to_lm ) )
+        difference = std::max( difference, from_to_lm - to_to_lm );
+    }
+    bound = std::max( bound, difference - tolerance[k] );
+  }
+  return bound;
+}
+
+} // namespace map
+} // namespace adore
@@ -162,6 +162,23 @@ Lane::get_speed_limit() const
   return speed_limit;
 }
 
+void
+Road::add_lane( LaneID lane_id )
+{
+  if( std::find( lane_ids.begin(), lane_ids.end(), lane_id ) == lane_ids.end() )
+    lane_ids.push_back( lane_id );
+}
+
+bool
+Road::remove_lane( LaneID lane_id )
+{
+  auto it = std::find( lane_ids.begin(), lane_ids.end(), lane_id );
+  if( it == lane_ids.end() )
+    return false;
+  lane_ids.erase( it );
+  return true;
+}
+
 void
 Road::set_category( const std::string &road_category_str )
 {
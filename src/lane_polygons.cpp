@@ -0,0 +1,280 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/lane_polygons.hpp"
+
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
+
+#include "adore_map/parallel.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+namespace
+{
+
+// Distance of p to the segment from a to b
+double
+distance_to_segment( const MapPoint& p, const MapPoint& a, const MapPoint& b )
+{
+  const double dx        = b.x - a.x;
+  const double dy        = b.y - a.y;
+  const double length_sq = dx * dx + dy * dy;
+  if( length_sq <= 0.0 )
+    return std::hypot( p.x - a.x, p.y - a.y );
+
+  const double t = std::clamp( ( ( p.x - a.x ) * dx + ( p.y - a.y ) * dy ) / length_sq, 0.0, 1.0 );
+  return std::hypot( p.x - ( a.x + t * dx ), p.y - ( a.y + t * dy ) );
+}
+
+// Douglas-Peucker simplification, appends the kept points to vertices
+void
+append_simplified( const std::vector<MapPoint>& points, double tolerance, std::vector<adore::math::Point2d>& vertices )
+{
+  if( points.empty() )
+    return;
+
+  std::vector<bool> keep( points.size(), false );
+  keep.front() = true;
+  keep.back()  = true;
+
+  std::vector<std::pair<size_t, size_t>> ranges{ { 0, points.size() - 1 } };
+  while( !ranges.empty() )
+  {
+    const auto [first, last] = ranges.back();
+    ranges.pop_back();
+
+    double max_dist  = 0.0;
+    size_t max_index = first;
+    for( size_t i = first + 1; i < last; ++i )
+    {
+      const double dist = distance_to_segment( points[i], points[first], points[last] );
+      if( dist > max_dist )
+      {
+        max_dist  = dist;
+        max_index = i;
+      }
+    }
+
+    if( max_dist > tolerance )
+    {
+      keep[max_index] = true;
+      ranges.emplace_back( first, max_index );
+      ranges.emplace_back( max_index, last );
+    }
+  }
+
+  for( size_t i = 0; i < points.size(); ++i )
+  {
+    if( keep[i] )
+      vertices.push_back( { points[i].x, points[i].y } );
+  }
+}
+
+const std::vector<MapPoint>&
+border_points( const Border& border )
+{
+  return border.interpolated_points.empty() ? border.points : border.interpolated_points;
+}
+
+LanePolygonIndex::Boundary
+empty_box()
+{
+  const double max = std::numeric_limits<double>::max();
+  return { max, -max, max, -max };
+}
+
+void
+expand( LanePolygonIndex::Boundary& box, const LanePolygonIndex::Boundary& other )
+{
+  box.x_min = std::min( box.x_min, other.x_min );
+  box.x_max = std::max( box.x_max, other.x_max );
+  box.y_min = std::min( box.y_min, other.y_min );
+  box.y_max = std::max( box.y_max, other.y_max );
+}
+
+} // namespace
+
+bool
+LanePolygon::contains( double x, double y ) const
+{
+  if( vertices.size() < 3 || x < box.x_min || x > box.x_max || y < box.y_min || y > box.y_max )
+    return false;
+
+  bool inside = false;
+  for( size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++ )
+  {
+    const auto& a = vertices[i];
+    const auto& b = vertices[j];
+    if( ( a.y > y ) != ( b.y > y ) && x < ( b.x - a.x ) * ( y - a.y ) / ( b.y - a.y ) + a.x )
+      inside = !inside;
+  }
+  return inside;
+}
+
+LanePolygon
+make_lane_polygon( const Lane& lane, double tolerance )
+{
+  LanePolygon polygon;
+  polygon.lane_id = lane.id;
+  polygon.box     = empty_box();
+
+  append_simplified( border_points( lane.borders.inner ), tolerance, polygon.vertices );
+
+  std::vector<MapPoint> outer( border_points( lane.borders.outer ).rbegin(), border_points( lane.borders.outer ).rend() );
+  append_simplified( outer, tolerance, polygon.vertices );
+
+  for( const auto& vertex : polygon.vertices )
+  {
+    polygon.box.x_min = std::min( polygon.box.x_min, vertex.x );
+    polygon.box.x_max = std::max( polygon.box.x_max, vertex.x );
+    polygon.box.y_min = std::min( polygon.box.y_min, vertex.y );
+    polygon.box.y_max = std::max( polygon.box.y_max, vertex.y );
+  }
+  return polygon;
+}
+
+LanePolygonIndex
+LanePolygonIndex::build( const LaneStore& lanes, double tolerance, size_t thread_count )
+{
+  LanePolygonIndex index;
+
+  std::vector<const Lane*> lane_list;
+  for( const auto& [lane_id, lane] : lanes )
+  {
+    if( lane )
+      lane_list.push_back( lane.get() );
+  }
+  std::sort( lane_list.begin(), lane_list.end(), []( const Lane* a, const Lane* b ) { return a->id < b->id; } );
+
+  index.polygons.resize( lane_list.size() );
+  parallel_for( lane_list.size(), thread_count, [&]( size_t i ) { index.polygons[i] = make_lane_polygon( *lane_list[i], tolerance ); } );
+
+  // Lanes without enough border points cannot contain anything
+  index.polygons.erase( std::remove_if( index.polygons.begin(), index.polygons.end(),
+                                        []( const LanePolygon& polygon ) { return polygon.vertices.size() < 3; } ),
+                        index.polygons.end() );
+
+  if( !index.polygons.empty() )
+    index.build_node( 0, index.polygons.size() );
+
+  index.by_id.reserve( index.polygons.size() );
+  for( size_t i = 0; i < index.polygons.size(); ++i )
+    index.by_id.emplace_back( index.polygons[i].lane_id, static_cast<uint32_t>( i ) );
+  std::sort( index.by_id.begin(), index.by_id.end() );
+
+  return index;
+}
+
+uint32_t
+LanePolygonIndex::build_node( size_t begin, size_t end )
+{
+  const auto node_index = static_cast<uint32_t>( nodes.size() );
+  nodes.emplace_back();
+
+  Boundary box = empty_box();
+  for( size_t i = begin; i < end; ++i )
+    expand( box, polygons[i].box );
+  nodes[node_index].box = box;
+
+  if( end - begin <= LEAF_SIZE )
+  {
+    nodes[node_index].leaf  = true;
+    nodes[node_index].left  = static_cast<uint32_t>( begin );
+    nodes[node_index].right = static_cast<uint32_t>( end - begin );
+    return node_index;
+  }
+
+  // Split at the median box center along the longer side
+  const bool   split_x = box.x_max - box.x_min >= box.y_max - box.y_min;
+  const size_t middle  = begin + ( end - begin ) / 2;
+  std::nth_element( polygons.begin() + begin, polygons.begin() + middle, polygons.begin() + end,
+                    [split_x]( const LanePolygon& a, const LanePolygon& b ) {
+                      return split_x ? a.box.x_min + a.box.x_max < b.box.x_min + b.box.x_max
+                                     : a.box.y_min + a.box.y_max < b.box.y_min + b.box.y_max;
+                    } );
+
+  const uint32_t left     = build_node( begin, middle );
+  const uint32_t right    = build_node( middle, end );
+  nodes[node_index].left  = left;
+  nodes[node_index].right = right;
+  return node_index;
+}
+
+template<typename Visitor>
+void
+LanePolygonIndex::visit( const Boundary& window, Visitor&& visitor ) const
+{
+  if( nodes.empty() )
+    return;
+
+  std::vector<uint32_t> stack{ 0 };
+  while( !stack.empty() )
+  {
+    const Node& node = nodes[stack.back()];
+    stack.pop_back();
+    if( !node.box.intersects( window ) )
+      continue;
+
+    if( !node.leaf )
+    {
+      stack.push_back( node.left );
+      stack.push_back( node.right );
+      continue;
+    }
+
+    for( uint32_t i = node.left; i < node.left + node.right; ++i )
+    {
+      if( polygons[i].box.intersects( window ) )
+        visitor( polygons[i] );
+    }
+  }
+}
+
+std::vector<LaneID>
+LanePolygonIndex::lanes_containing( double x, double y ) const
+{
+  std::vector<LaneID> lane_ids;
+  visit( Boundary{ x, x, y, y }, [&]( const LanePolygon& polygon ) {
+    if( polygon.contains( x, y ) )
+      lane_ids.push_back( polygon.lane_id );
+  } );
+  std::sort( lane_ids.begin(), lane_ids.end() );
+  return lane_ids;
+}
+
+std::vector<LaneID>
+LanePolygonIndex::lanes_overlapping( const Boundary& window ) const
+{
+  std::vector<LaneID> lane_ids;
+  visit( window, [&]( const LanePolygon& polygon ) { lane_ids.push_back( polygon.lane_id ); } );
+  std::sort( lane_ids.begin(), lane_ids.end() );
+  return lane_ids;
+}
+
+const LanePolygon*
+LanePolygonIndex::find( LaneID lane_id ) const
+{
+  auto it = std::lower_bound( by_id.begin(), by_id.end(), std::make_pair( lane_id, uint32_t{ 0 } ) );
+  if( it == by_id.end() || it->first != lane_id )
+    return nullptr;
+  return &polygons[it->second];
+}
+
+} // namespace map
+} // namespace adore
@@ -15,6 +15,8 @@
 
 #include "adore_map/helpers.hpp"
 
+#include <unordered_set>
+
 namespace adore
 {
 namespace map
@@ -35,5 +37,286 @@ Map::get_lane_speed_limit( size_t lane_id ) const
   return 13.6;
 }
 
+void
+Map::insert_lane( const std::shared_ptr<Lane>& lane )
+{
+  if( !lane )
+    return;
+
+  // A lane under an id that is already stored replaces the old one, its connections in lane_graph stay
+  auto [lane_it, inserted] = lanes.insert( lane );
+  std::shared_ptr<Lane> replaced;
+  if( !inserted )
+  {
+    replaced        = lane_it->second;
+    lane_it->second = lane;
+  }
+  if( replaced )
+  {
+    const LaneID lane_id = lane->id;
+    for( const auto& point : replaced->borders.center.interpolated_points )
+    {
+      quadtree.remove( point, [lane_id]( const MapPoint& p ) { return p.parent_id == lane_id; } );
+    }
+
+    auto road_it = roads.find( replaced->road_id );
+    if( replaced->road_id != lane->road_id && road_it != roads.end() )
+    {
+      road_it->second.remove_lane( lane_id );
+      if( road_it->second.lane_ids.empty() )
+        roads.erase( road_it );
+    }
+  }
+
+  lane_polygons.reset();
+  forget_moved_position( *lane );
+  boundaries.reset();
+  update_raster( lane->id );
+  if( replaced )
+    update_tiles( *replaced );
+  update_tiles( *lane );
+  for( const auto& point : lane->borders.center.interpolated_points )
+  {
+    quadtree.insert( point );
+  }
+
+  auto road_it = roads.find( lane->road_id );
+  if( road_it != roads.end() )
+    road_it->second.add_lane( lane->id );
+}
+
+bool
+Map::remove_lane( LaneID lane_id )
+{
+  auto lane_it = lanes.find( lane_id );
+  if( lane_it == lanes.end() )
+    return false;
+
+  const auto lane = lane_it->second;
+  if( lane )
+  {
+    for( const auto& point : lane->borders.center.interpolated_points )
+    {
+      quadtree.remove( point, [lane_id]( const MapPoint& p ) { return p.parent_id == lane_id; } );
+    }
+
+    auto road_it = roads.find( lane->road_id );
+    if( road_it != roads.end() )
+    {
+      road_it->second.remove_lane( lane_id );
+      if( road_it->second.lane_ids.empty() )
+        roads.erase( road_it );
+    }
+  }
+
+  lane_graph.remove_lane( lane_id );
+  lanes.erase( lane_id );
+  lane_polygons.reset();
+  boundaries.reset();
+  update_raster( lane_id );
+  if( lane )
+    update_tiles( *lane );
+  return true;
+}
+
+void
+Map::build_tiles( double tile_size, size_t thread_count )
+{
+  tiles = std::make_shared<const TileGrid>( TileGrid::build( lanes, tile_size, thread_count ) );
+}
+
+std::vector<LaneID>
+Map::get_lane_ids_in( const Quadtree<MapPoint>::Boundary& window ) const
+{
+  if( tiles )
+    return tiles->get_lane_ids( window );
+
+  std::vector<LaneID> lane_ids;
+  quadtree.visit( window, [&]( const MapPoint& point ) { lane_ids.push_back( point.parent_id ); } );
+  std::sort( lane_ids.begin(), lane_ids.end() );
+  lane_ids.erase( std::unique( lane_ids.begin(), lane_ids.end() ), lane_ids.end() );
+  return lane_ids;
+}
+
+void
+Map::build_lane_polygons( double tolerance, size_t thread_count )
+{
+  lane_polygons = std::make_shared<const LanePolygonIndex>( LanePolygonIndex::build( lanes, tolerance, thread_count ) );
+}
+
+void
+Map::build_raster( const RasterConfig& config, size_t thread_count )
+{
+  raster = std::make_shared<const MapRaster>( MapRaster::build( lanes, config, thread_count ) );
+}
+
+void
+Map::build_boundaries( const BoundaryConfig& config, size_t thread_count )
+{
+  boundaries = std::make_shared<const BoundaryIndex>( BoundaryIndex::build( lanes, config, thread_count, lane_polygons.get() ) );
+}
+
+void
+Map::update_raster( LaneID lane_id )
+{
+  if( !raster )
+    return;
+
+  // Copy on write, snapshots sharing the old raster keep it; unchanged tiles are shared by both
+  auto updated = std::make_shared<MapRaster>( *raster );
+  updated->update( lanes, { lane_id }, 1 );
+  raster = updated;
+}
+
+void
+Map::forget_moved_position( const Lane& lane )
+{
+  if( !lane_graph.lane_positions )
+    return;
+
+  // A lane inserted again under the same id but elsewhere no longer starts at its recorded position
+  const auto* position = lane_graph.lane_positions->find( lane.id );
+  const auto& points   = lane.borders.center.interpolated_points;
+  if( !position || points.empty() )
+    return;
+  const auto& entry = lane.left_of_reference ? points.back() : points.front();
+  if( position->x == entry.x && position->y == entry.y )
+    return;
+
+  // Record the positions of the current lanes, so A* estimates from where the lanes are now
+  lane_graph.lane_positions.reset();
+  if( lane_graph.compact )
+    lane_graph.build_compact( &lanes );
+}
+
+void
+Map::update_tiles( const Lane& lane )
+{
+  if( !tiles )
+    return;
+
+  std::unordered_set<TileKey, TileKeyHasher> keys;
+  for( const auto& point : lane.borders.center.interpolated_points )
+    keys.insert( tiles->get_key( point.x, point.y ) );
+
+  // Copy on write like the raster, snapshots sharing the old grid keep it; unchanged tiles are shared by both
+  auto updated = std::make_shared<TileGrid>( *tiles );
+  for( const auto& key : keys )
+  {
+    std::vector<LaneID> lane_ids{ lane.id };
+    if( const auto tile = tiles->get_tile( key ) )
+      lane_ids.insert( lane_ids.end(), tile->lane_ids.begin(), tile->lane_ids.end() );
+
+    auto tile = updated->build_tile( key, lanes, lane_ids );
+    if( tile->lane_ids.empty() )
+      updated->remove_tile( key );
+    else
+      updated->set_tile( tile );
+  }
+  tiles = updated;
+}
+
+std::vector<LaneID>
+Map::lanes_containing( double x, double y ) const
+{
+  if( lane_polygons )
+    return lane_polygons->lanes_containing( x, y );
+
+  // A point inside a lane is within half a lane width and half a sample spacing of one of its center points
+  const double        radius = 10.0;
+  std::vector<LaneID> lane_ids;
+  for( const auto lane_id : get_lane_ids_in( { x - radius, x + radius, y - radius, y + radius } ) )
+  {
+    auto lane_it = lanes.find( lane_id );
+    if( lane_it != lanes.end() && lane_it->second && make_lane_polygon( *lane_it->second, 0.0 ).contains( x, y ) )
+      lane_ids.push_back( lane_id );
+  }
+  return lane_ids;
+}
+
+std::optional<math::Pose2d>
+Map::from_frenet( const FrenetCoordinate& frenet ) const
+{
+  auto lane_it = lanes.find( frenet.lane_id );
+  if( lane_it == lanes.end() || !lane_it->second )
+    return {};
+  return lane_frenet_to_pose( *lane_it->second, frenet.s, frenet.d );
+}
+
+std::vector<std::vector<double>>
+get_map_distances( const std::vector<MapPoint>& start_points, const std::vector<MapPoint>& end_points,
+                   const std::shared_ptr<const Map>& map, size_t thread_count, const WeightOverlay* overlay )
+{
+  std::vector<std::vector<double>> distances( start_points.size(),
+                                              std::vector<double>( end_points.size(), std::numeric_limits<double>::infinity() ) );
+
+  std::vector<LaneID> start_lanes, end_lanes;
+  for( const auto& point : start_points )
+    start_lanes.push_back( point.parent_id );
+  for( const auto& point : end_points )
+    end_lanes.push_back( point.parent_id );
+  std::sort( start_lanes.begin(), start_lanes.end() );
+  start_lanes.erase( std::unique( start_lanes.begin(), start_lanes.end() ), start_lanes.end() );
+  std::sort( end_lanes.begin(), end_lanes.end() );
+  end_lanes.erase( std::unique( end_lanes.begin(), end_lanes.end() ), end_lanes.end() );
+
+  // Ends of a lane's center line in s, lanes without points add nothing as in get_map_distance
+  auto first_s    = []( const Lane& lane ) { return lane.borders.center.interpolated_points.front().s; };
+  auto last_s     = []( const Lane& lane ) { return lane.borders.center.interpolated_points.back().s; };
+  auto has_points = []( const Lane& lane ) { return !lane.borders.center.interpolated_points.empty(); };
+
+  parallel_for( start_lanes.size(), thread_count, [&]( size_t task ) {
+    const LaneID start_lane = start_lanes[task];
+    const auto   reachable  = map->lane_graph.find_reachable( start_lane, std::numeric_limits<double>::infinity(), BOTH, true, end_lanes, overlay );
+
+    // Length of the lanes strictly between the start lane and each reached lane on the route to it. Parents
+    // come before their children in the reached order.
+    std::vector<double> between( reachable.lanes.size(), 0.0 );
+    for( size_t i = 1; i < reachable.lanes.size(); ++i )
+    {
+      const size_t parent = reachable.index.at( reachable.lanes[i].previous );
+      between[i]          = between[parent];
+      if( parent != 0 )
+      {
+        const auto& lane = *map->lanes.at( reachable.lanes[parent].lane_id );
+        if( has_points( lane ) )
+          between[i] += std::abs( last_s( lane ) - first_s( lane ) );
+      }
+    }
+
+    for( size_t row = 0; row < start_points.size(); ++row )
+    {
+      const auto& start = start_points[row];
+      if( start.parent_id != start_lane )
+        continue;
+
+      const auto& first_lane = *map->lanes.at( start_lane );
+      for( size_t column = 0; column < end_points.size(); ++column )
+      {
+        const auto& end = end_points[column];
+        auto        it  = reachable.index.find( end.parent_id );
+        if( it == reachable.index.end() )
+          continue;
+
+        if( it->second == 0 )
+        {
+          distances[row][column] = has_points( first_lane ) ? std::abs( end.s - start.s ) : 0.0;
+          continue;
+        }
+
+        const auto& last_lane = *map->lanes.at( end.parent_id );
+        double      distance  = between[it->second];
+        if( has_points( first_lane ) )
+          distance += std::abs( last_s( first_lane ) - start.s );
+        if( has_points( last_lane ) )
+          distance += std::abs( end.s - first_s( last_lane ) );
+        distances[row][column] = distance;
+      }
+    }
+  } );
+
+  return distances;
+}
+
 } // namespace map
 } // namespace adore
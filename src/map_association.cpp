@@ -0,0 +1,69 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/map_association.hpp"
+
+#include <cmath>
+
+#include <limits>
+
+#include "adore_map/frenet.hpp"
+#include "adore_math/angles.h"
+
+namespace adore
+{
+namespace map
+{
+
+LaneAssociation
+associate_pose( const Map& map, double x, double y, double yaw )
+{
+  LaneAssociation association;
+
+  const MapPoint query( x, y, 0 );
+  double         min_dist = std::numeric_limits<double>::max();
+  auto           nearest  = map.quadtree.get_nearest_point( query, min_dist );
+  if( !nearest )
+    return association;
+
+  auto lane_it = map.lanes.find( nearest->parent_id );
+  if( lane_it == map.lanes.end() || !lane_it->second )
+    return association;
+
+  const auto& lane = *lane_it->second;
+
+  // Same projection as Map::to_frenet, so s and the offset agree with the Frenet conversions
+  const auto frenet = project_onto_lane( lane, x, y, nearest->s );
+  const auto center = evaluate_center_line( lane, frenet.s );
+
+  association.found          = true;
+  association.lane_id        = nearest->parent_id;
+  association.s              = frenet.s;
+  association.lateral_offset = frenet.d;
+  association.lane_width     = lane.get_width( nearest->s );
+  association.on_road        = min_dist < association.lane_width / 2;
+
+  // Frenet offsets are positive left of increasing s, lanes left of the reference line are driven against it
+  double lane_yaw = std::atan2( center.dy, center.dx );
+  if( lane.left_of_reference )
+  {
+    association.lateral_offset = -association.lateral_offset;
+    lane_yaw                  += M_PI;
+  }
+  association.heading_difference = math::normalize_angle( yaw - lane_yaw );
+
+  return association;
+}
+
+} // namespace map
+} // namespace adore
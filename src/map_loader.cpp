@@ -42,14 +42,18 @@ MapLoader::load_from_file( const std::string& map_file_location, bool allow_lane
     return load_from_r2s_file( map_file_location, allow_lane_changes, ignore_non_driving );
   }
 
+  if( extension == "admap" )
+  {
+    return load_compiled( map_file_location );
+  }
+
   throw std::invalid_argument( "Unsupported file extension: " + extension );
 }
 
-size_t
-MapLoader::generate_lane_id()
+Map
+MapLoader::load_compiled( const std::string& compiled_map_location )
 {
-  static size_t lane_id_counter = 0;
-  return ++lane_id_counter;
+  return CompiledMap::open( compiled_map_location ).to_map();
 }
 
 Map
@@ -97,6 +101,9 @@ MapLoader::create_from_r2s( Map& map, const std::vector<r2s::BorderDataR2SR>& st
     id_to_border[boundary.id] = boundary_pointer;
   }
 
+  // Lane ids are counted per load, so loading the same data always yields the same ids
+  LaneID lane_id_counter = 0;
+
   for( const auto& r2s_ref_line : standard_lines )
   {
     // Create a Road object for each reference line
@@ -113,7 +120,7 @@ MapLoader::create_from_r2s( Map& map, const std::vector<r2s::BorderDataR2SR>& st
       std::vector<BorderWithOffset> clipped_borders = get_clipped_borders( relevant_borders, reference_line, *s_iter, *( s_iter + 1 ) );
       for( size_t i = 1; i < clipped_borders.size(); ++i )
       {
-        make_lane( clipped_borders[i - 1], clipped_borders[i], road, map, id_to_border );
+        make_lane( clipped_borders[i - 1], clipped_borders[i], ++lane_id_counter, road, map, id_to_border );
       }
     }
     map.roads[r2s_ref_line.id] = road;
@@ -125,14 +132,15 @@ MapLoader::create_from_r2s( Map& map, const std::vector<r2s::BorderDataR2SR>& st
     constexpr double lane_change_penalty = 5.0;
     add_parallel_connections_same_road( map, map.lane_graph, lane_change_penalty );
   }
+  map.lane_graph.build_compact( &map.lanes );
 }
 
 void
-MapLoader::make_lane( const BorderWithOffset& left_border, const BorderWithOffset& right_border, Road& road, Map& map,
+MapLoader::make_lane( const BorderWithOffset& left_border, const BorderWithOffset& right_border, LaneID lane_id, Road& road, Map& map,
                       const std::unordered_map<int, std::shared_ptr<r2s::BorderDataR2SL>>& id_to_border )
 {
   bool left_of_reference = left_border.lateral_offset < 0.0;
-  auto lane_ptr          = std::make_shared<Lane>( left_border.clipped_border, right_border.clipped_border, generate_lane_id(), road.id,
+  auto lane_ptr          = std::make_shared<Lane>( left_border.clipped_border, right_border.clipped_border, lane_id, road.id,
                                                    left_of_reference );
 
   int boundary_id = left_of_reference ? left_border.clipped_border.points.front().parent_id
@@ -145,8 +153,8 @@ MapLoader::make_lane( const BorderWithOffset& left_border, const BorderWithOffse
     lane_ptr->set_type( boundary->linetype, road.category );
   }
 
-  map.lanes[lane_ptr->id] = lane_ptr;
-  road.lanes.insert( lane_ptr );
+  map.lanes.insert( lane_ptr );
+  road.add_lane( lane_ptr->id );
 
   for( const auto& p : lane_ptr->borders.center.interpolated_points )
   {
@@ -334,9 +342,16 @@ MapLoader::add_parallel_connections_same_road( Map& map, RoadGraph& lane_graph,
   //   - have the same driving direction (left_of_reference)
   for( const auto& [road_id, road] : map.roads )
   {
-    // copy set<shared_ptr<Lane>> to a vector for indexed iteration
-    std::vector<std::shared_ptr<Lane>> road_lanes( road.lanes.begin(), road.lanes.end() );
-    const std::size_t                  n = road_lanes.size();
+    // resolve the road's lane ids through the lane store
+    std::vector<std::shared_ptr<Lane>> road_lanes;
+    road_lanes.reserve( road.lane_ids.size() );
+    for( LaneID lane_id : road.lane_ids )
+    {
+      auto lane_it = map.lanes.find( lane_id );
+      if( lane_it != map.lanes.end() )
+        road_lanes.push_back( lane_it->second );
+    }
+    const std::size_t n = road_lanes.size();
 
     for( std::size_t i = 0; i < n; ++i )
     {
@@ -485,7 +500,7 @@ MapLoader::load_from_xodr_file( const std::string& filename, bool ignore_non_dri
 
         lane_mapping[lane.key] = adore_lane_ptr->id;
 
-        adore_road.lanes.insert( adore_lane_ptr );
+        adore_road.add_lane( adore_lane_ptr->id );
 
         // TODO set road/lane categories
 
@@ -493,7 +508,7 @@ MapLoader::load_from_xodr_file( const std::string& filename, bool ignore_non_dri
         {
           adore_road_map.quadtree.insert( p );
         }
-        adore_road_map.lanes[adore_lane_ptr->id] = adore_lane_ptr;
+        adore_road_map.lanes.insert( adore_lane_ptr );
       }
       adore_road_map.roads[adore_road.id] = adore_road;
     }
@@ -514,6 +529,7 @@ MapLoader::load_from_xodr_file( const std::string& filename, bool ignore_non_dri
     connection.connection_type = END_TO_START;
     adore_road_map.lane_graph.add_connection( connection );
   }
+  adore_road_map.lane_graph.build_compact( &adore_road_map.lanes );
   return adore_road_map;
 }
 
@@ -0,0 +1,176 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/map_tiles.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "adore_map/parallel.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+TileGrid::TileGrid( double tile_size_, double origin_x_, double origin_y_ ) :
+  tile_size( tile_size_ ),
+  origin_x( origin_x_ ),
+  origin_y( origin_y_ )
+{
+  if( !( tile_size > 0.0 ) )
+    throw std::invalid_argument( "TileGrid: tile size must be positive" );
+}
+
+TileGrid
+TileGrid::build( const LaneStore& lanes, double tile_size, size_t thread_count )
+{
+  TileGrid grid( tile_size );
+
+  // Bucket lanes by the cells their center points fall into
+  std::unordered_map<TileKey, std::vector<LaneID>, TileKeyHasher> lanes_per_tile;
+  for( const auto& [lane_id, lane] : lanes )
+  {
+    for( const auto& point : lane->borders.center.interpolated_points )
+    {
+      auto& tile_lanes = lanes_per_tile[grid.get_key( point.x, point.y )];
+      if( tile_lanes.empty() || tile_lanes.back() != lane_id )
+        tile_lanes.push_back( lane_id );
+    }
+  }
+
+  std::vector<std::pair<TileKey, std::vector<LaneID>>> work( lanes_per_tile.begin(), lanes_per_tile.end() );
+  std::vector<std::shared_ptr<const MapTile>>          built( work.size() );
+
+  // Each tile only reads the shared lanes, so tiles are independent and can be built concurrently
+  parallel_for( work.size(), thread_count, [&]( size_t i ) { built[i] = grid.build_tile( work[i].first, lanes, work[i].second ); } );
+
+  for( const auto& tile : built )
+    grid.set_tile( tile );
+
+  return grid;
+}
+
+std::shared_ptr<const MapTile>
+TileGrid::build_tile( const TileKey& key, const LaneStore& lanes, const std::vector<LaneID>& lane_ids ) const
+{
+  auto tile            = std::make_shared<MapTile>();
+  tile->key            = key;
+  tile->boundary       = get_tile_boundary( key );
+  tile->index.boundary = tile->boundary;
+
+  // Pad the local index a little, so points rounding onto the cell edge are still accepted
+  const double padding         = 1e-6 * tile_size;
+  tile->index.boundary.x_min -= padding;
+  tile->index.boundary.x_max += padding;
+  tile->index.boundary.y_min -= padding;
+  tile->index.boundary.y_max += padding;
+
+  std::vector<LaneID> candidate_ids( lane_ids );
+  std::sort( candidate_ids.begin(), candidate_ids.end() );
+  candidate_ids.erase( std::unique( candidate_ids.begin(), candidate_ids.end() ), candidate_ids.end() );
+
+  for( const auto& lane_id : candidate_ids )
+  {
+    auto lane_it = lanes.find( lane_id );
+    if( lane_it == lanes.end() )
+      continue;
+
+    bool lane_in_tile = false;
+    for( const auto& point : lane_it->second->borders.center.interpolated_points )
+    {
+      if( !( get_key( point.x, point.y ) == key ) )
+        continue;
+      tile->index.insert( point );
+      lane_in_tile = true;
+    }
+    if( lane_in_tile )
+      tile->lane_ids.push_back( lane_id );
+  }
+
+  return tile;
+}
+
+TileGrid::Boundary
+TileGrid::get_tile_boundary( const TileKey& key ) const
+{
+  Boundary boundary;
+  boundary.x_min = origin_x + static_cast<double>( key.ix ) * tile_size;
+  boundary.x_max = boundary.x_min + tile_size;
+  boundary.y_min = origin_y + static_cast<double>( key.iy ) * tile_size;
+  boundary.y_max = boundary.y_min + tile_size;
+  return boundary;
+}
+
+std::shared_ptr<const MapTile>
+TileGrid::get_tile( const TileKey& key ) const
+{
+  auto it = tiles.find( key );
+  return it == tiles.end() ? nullptr : it->second;
+}
+
+void
+TileGrid::set_tile( const std::shared_ptr<const MapTile>& tile )
+{
+  if( tile )
+    tiles[tile->key] = tile;
+}
+
+void
+TileGrid::remove_tile( const TileKey& key )
+{
+  tiles.erase( key );
+}
+
+std::vector<std::shared_ptr<const MapTile>>
+TileGrid::get_tiles( const Boundary& window ) const
+{
+  std::vector<std::shared_ptr<const MapTile>> found;
+
+  const TileKey min_key = get_key( window.x_min, window.y_min );
+  const TileKey max_key = get_key( window.x_max, window.y_max );
+  for( int64_t ix = min_key.ix; ix <= max_key.ix; ++ix )
+  {
+    for( int64_t iy = min_key.iy; iy <= max_key.iy; ++iy )
+    {
+      if( auto tile = get_tile( { ix, iy } ) )
+        found.push_back( tile );
+    }
+  }
+  return found;
+}
+
+std::vector<LaneID>
+TileGrid::get_lane_ids( const Boundary& window ) const
+{
+  std::vector<LaneID> lane_ids;
+
+  for( const auto& tile : get_tiles( window ) )
+  {
+    const auto& cell = tile->boundary;
+    if( window.x_min <= cell.x_min && window.x_max >= cell.x_max && window.y_min <= cell.y_min && window.y_max >= cell.y_max )
+    {
+      // Tile lies completely inside the window, all of its lanes qualify
+      lane_ids.insert( lane_ids.end(), tile->lane_ids.begin(), tile->lane_ids.end() );
+      continue;
+    }
+    tile->index.visit( window, [&]( const MapPoint& point ) { lane_ids.push_back( point.parent_id ); } );
+  }
+
+  std::sort( lane_ids.begin(), lane_ids.end() );
+  lane_ids.erase( std::unique( lane_ids.begin(), lane_ids.end() ), lane_ids.end() );
+  return lane_ids;
+}
+
+} // namespace map
+} // namespace adore
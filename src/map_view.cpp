@@ -0,0 +1,126 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/map_view.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+MapView::MapView( const std::shared_ptr<const Map>& parent_map, const Boundary& boundary_, std::vector<LaneID> lane_ids_ ) :
+  parent( parent_map ),
+  boundary( boundary_ ),
+  lane_ids( std::move( lane_ids_ ) )
+{
+  std::sort( lane_ids.begin(), lane_ids.end() );
+  lane_ids.erase( std::unique( lane_ids.begin(), lane_ids.end() ), lane_ids.end() );
+
+  // Drop ids that the parent does not know, so every id of the view resolves to a lane
+  if( parent )
+  {
+    lane_ids.erase( std::remove_if( lane_ids.begin(), lane_ids.end(),
+                                    [this]( LaneID lane_id ) { return parent->lanes.count( lane_id ) == 0; } ),
+                    lane_ids.end() );
+  }
+  else
+  {
+    lane_ids.clear();
+  }
+}
+
+bool
+MapView::contains_lane( LaneID lane_id ) const
+{
+  return std::binary_search( lane_ids.begin(), lane_ids.end(), lane_id );
+}
+
+std::shared_ptr<const Lane>
+MapView::get_lane( LaneID lane_id ) const
+{
+  if( !contains_lane( lane_id ) )
+    return nullptr;
+  return parent->lanes.at( lane_id );
+}
+
+std::vector<LaneID>
+MapView::get_successors( LaneID lane_id ) const
+{
+  std::vector<LaneID> successors;
+  if( !contains_lane( lane_id ) )
+    return successors;
+
+  auto successors_it = parent->lane_graph.to_successors.find( lane_id );
+  if( successors_it == parent->lane_graph.to_successors.end() )
+    return successors;
+
+  for( const auto& successor : successors_it->second )
+  {
+    if( contains_lane( successor ) )
+      successors.push_back( successor );
+  }
+  return successors;
+}
+
+std::deque<LaneID>
+MapView::find_path( LaneID from, LaneID to, bool allow_reverse ) const
+{
+  if( !contains_lane( from ) || !contains_lane( to ) )
+    return {};
+
+  return parent->lane_graph.find_path( from, to, allow_reverse, [this]( LaneID lane_id ) { return contains_lane( lane_id ); } );
+}
+
+Map
+MapView::to_map() const
+{
+  Map submap;
+  if( !parent )
+    return submap;
+
+  submap.quadtree.boundary = boundary;
+  submap.quadtree.capacity = parent->quadtree.capacity;
+  submap.lanes.reserve( lane_ids.size() );
+
+  std::unordered_set<LaneID> valid_lane_ids( lane_ids.begin(), lane_ids.end() );
+
+  for( const auto& lane_id : lane_ids )
+  {
+    const auto& lane = parent->lanes.at( lane_id );
+    submap.lanes.insert( lane );
+
+    for( const auto& point : lane->borders.center.interpolated_points )
+    {
+      submap.quadtree.insert( point );
+    }
+
+    auto road_it = parent->roads.find( lane->road_id );
+    if( road_it == parent->roads.end() )
+      continue;
+
+    auto submap_road_it = submap.roads.find( road_it->first );
+    if( submap_road_it == submap.roads.end() )
+    {
+      Road road = road_it->second;
+      road.lane_ids.clear();
+      submap_road_it = submap.roads.emplace( road_it->first, std::move( road ) ).first;
+    }
+    submap_road_it->second.add_lane( lane_id );
+  }
+
+  submap.lane_graph = parent->lane_graph.create_subgraph( valid_lane_ids );
+  return submap;
+}
+
+} // namespace map
+} // namespace adore
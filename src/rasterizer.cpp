@@ -0,0 +1,210 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/rasterizer.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+#include "adore_map/parallel.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+MapRaster::MapRaster( const RasterConfig& config_ ) :
+  config( config_ )
+{
+  if( !( config.resolution > 0.0 ) || !( config.tile_size > 0.0 ) )
+    throw std::invalid_argument( "MapRaster: resolution and tile size must be positive" );
+
+  cells     = std::max<size_t>( 1, static_cast<size_t>( std::round( config.tile_size / config.resolution ) ) );
+  tile_size = cells * config.resolution;
+
+  for( const auto type : config.drivable_types )
+    drivable[static_cast<size_t>( type ) + 1] = true;
+}
+
+MapRaster
+MapRaster::build( const LaneStore& lanes, const RasterConfig& config, size_t thread_count )
+{
+  MapRaster           raster( config );
+  std::vector<LaneID> lane_ids;
+  for( const auto& [lane_id, lane] : lanes )
+    lane_ids.push_back( lane_id );
+  raster.update( lanes, lane_ids, thread_count );
+  return raster;
+}
+
+void
+MapRaster::update( const LaneStore& lanes, const std::vector<LaneID>& changed_lane_ids, size_t thread_count )
+{
+  // Outline the changed lanes that are (still) part of the store
+  std::vector<std::shared_ptr<const LanePolygon>> outlines( changed_lane_ids.size() );
+  parallel_for( changed_lane_ids.size(), thread_count, [&]( size_t i ) {
+    auto lane_it = lanes.find( changed_lane_ids[i] );
+    if( lane_it != lanes.end() && lane_it->second )
+      outlines[i] = std::make_shared<const LanePolygon>( make_lane_polygon( *lane_it->second, config.polygon_tolerance ) );
+  } );
+
+  std::vector<TileKey> affected;
+  for( size_t i = 0; i < changed_lane_ids.size(); ++i )
+  {
+    const LaneID lane_id = changed_lane_ids[i];
+
+    auto old_it = polygons.find( lane_id );
+    if( old_it != polygons.end() )
+    {
+      for( const auto& key : get_keys( old_it->second->box ) )
+      {
+        auto& ids = tile_lanes[key];
+        ids.erase( std::remove( ids.begin(), ids.end(), lane_id ), ids.end() );
+        affected.push_back( key );
+      }
+      polygons.erase( old_it );
+      lane_types.erase( lane_id );
+    }
+
+    if( !outlines[i] || outlines[i]->vertices.size() < 3 )
+      continue;
+
+    polygons[lane_id]   = outlines[i];
+    lane_types[lane_id] = lanes.at( lane_id )->type;
+    for( const auto& key : get_keys( outlines[i]->box ) )
+    {
+      tile_lanes[key].push_back( lane_id );
+      affected.push_back( key );
+    }
+  }
+
+  std::sort( affected.begin(), affected.end(), []( const TileKey& a, const TileKey& b ) {
+    return a.ix < b.ix || ( a.ix == b.ix && a.iy < b.iy );
+  } );
+  affected.erase( std::unique( affected.begin(), affected.end() ), affected.end() );
+  render_tiles( affected, thread_count );
+}
+
+std::shared_ptr<const RasterTile>
+MapRaster::get_tile( const TileKey& key ) const
+{
+  auto it = tiles.find( key );
+  if( it == tiles.end() )
+    return nullptr;
+  return it->second;
+}
+
+std::vector<TileKey>
+MapRaster::get_keys( const LanePolygonIndex::Boundary& box ) const
+{
+  const TileKey        min_key = get_key( box.x_min, box.y_min );
+  const TileKey        max_key = get_key( box.x_max, box.y_max );
+  std::vector<TileKey> keys;
+  for( int64_t ix = min_key.ix; ix <= max_key.ix; ++ix )
+  {
+    for( int64_t iy = min_key.iy; iy <= max_key.iy; ++iy )
+      keys.push_back( { ix, iy } );
+  }
+  return keys;
+}
+
+void
+MapRaster::render_tiles( const std::vector<TileKey>& keys, size_t thread_count )
+{
+  std::vector<std::shared_ptr<const RasterTile>> rendered( keys.size() );
+  parallel_for( keys.size(), thread_count, [&]( size_t i ) {
+    auto it = tile_lanes.find( keys[i] );
+    if( it != tile_lanes.end() && !it->second.empty() )
+      rendered[i] = render_tile( keys[i], it->second );
+  } );
+
+  for( size_t i = 0; i < keys.size(); ++i )
+  {
+    if( rendered[i] )
+    {
+      tiles[keys[i]] = rendered[i];
+    }
+    else
+    {
+      tiles.erase( keys[i] );
+      tile_lanes.erase( keys[i] );
+    }
+  }
+}
+
+std::shared_ptr<const RasterTile>
+MapRaster::render_tile( const TileKey& key, const std::vector<LaneID>& lane_ids ) const
+{
+  auto tile      = std::make_shared<RasterTile>();
+  tile->key      = key;
+  tile->x_min    = key.ix * tile_size;
+  tile->y_min    = key.iy * tile_size;
+  tile->cells    = cells;
+  tile->lane_ids = lane_ids;
+  std::sort( tile->lane_ids.begin(), tile->lane_ids.end() );
+  tile->lane_types.assign( cells * cells, RasterTile::NO_LANE );
+  tile->lane_slots.assign( cells * cells, RasterTile::NO_LANE );
+
+  if( tile->lane_ids.size() >= std::numeric_limits<uint16_t>::max() )
+    throw std::runtime_error( "MapRaster: too many lanes in one tile" );
+
+  // Paint the winning lanes last: drivable after other lanes, lower ids after higher ones
+  std::vector<size_t> order( tile->lane_ids.size() );
+  for( size_t i = 0; i < order.size(); ++i )
+    order[i] = order.size() - 1 - i;
+  std::stable_sort( order.begin(), order.end(), [&]( size_t a, size_t b ) {
+    return !drivable[lane_types.at( tile->lane_ids[a] ) + 1] && drivable[lane_types.at( tile->lane_ids[b] ) + 1];
+  } );
+
+  const double        resolution = config.resolution;
+  std::vector<double> crossings;
+  for( const size_t slot : order )
+  {
+    const auto&   polygon  = *polygons.at( tile->lane_ids[slot] );
+    const auto    type     = static_cast<uint8_t>( lane_types.at( polygon.lane_id ) + 1 );
+    const auto&   vertices = polygon.vertices;
+    const int64_t row_min  = std::max<int64_t>( 0, static_cast<int64_t>( std::ceil( ( polygon.box.y_min - tile->y_min ) / resolution - 0.5 ) ) );
+    const int64_t row_max  = std::min<int64_t>( cells, static_cast<int64_t>( std::ceil( ( polygon.box.y_max - tile->y_min ) / resolution - 0.5 ) ) );
+
+    // Scanline fill at the cell centers, with the same even-odd rule as LanePolygon::contains
+    for( int64_t row = row_min; row < row_max; ++row )
+    {
+      const double y = tile->y_min + ( row + 0.5 ) * resolution;
+      crossings.clear();
+      for( size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++ )
+      {
+        const auto& a = vertices[i];
+        const auto& b = vertices[j];
+        if( ( a.y > y ) != ( b.y > y ) )
+          crossings.push_back( ( b.x - a.x ) * ( y - a.y ) / ( b.y - a.y ) + a.x );
+      }
+      std::sort( crossings.begin(), crossings.end() );
+
+      for( size_t k = 0; k + 1 < crossings.size(); k += 2 )
+      {
+        const auto first = std::max<int64_t>( 0, static_cast<int64_t>( std::ceil( ( crossings[k] - tile->x_min ) / resolution - 0.5 ) ) );
+        const auto last  = std::min<int64_t>( cells, static_cast<int64_t>( std::ceil( ( crossings[k + 1] - tile->x_min ) / resolution - 0.5 ) ) );
+        for( int64_t column = first; column < last; ++column )
+        {
+          const size_t cell      = row * cells + column;
+          tile->lane_types[cell] = type;
+          tile->lane_slots[cell] = static_cast<uint16_t>( slot + 1 );
+        }
+      }
+    }
+  }
+  return tile;
+}
+
+} // namespace map
+} // namespace adore
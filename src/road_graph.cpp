@@ -13,11 +13,42 @@
 
 #include "adore_map/road_graph.hpp"
 
+#include <atomic>
+#include <stdexcept>
+#include <tuple>
+
+#include "adore_map/compact_road_graph.hpp"
+#include "adore_map/contraction_hierarchy.hpp"
+#include "adore_map/landmarks.hpp"
+#include "adore_map/weight_overlay.hpp"
+
 namespace adore
 {
 namespace map
 {
 
+namespace
+{
+
+// Graph versions are unique within the process, so two graphs never share one after a change
+uint64_t
+next_version()
+{
+  static std::atomic<uint64_t> counter{ 0 };
+  return ++counter;
+}
+
+// Overlays are made for one version of the graph, with any other they would bring back replaced weights
+const CompactRoadGraph&
+get_overlay_graph( const RoadGraph& graph, const WeightOverlay& overlay )
+{
+  const auto& overlay_graph = overlay.get_graph();
+  if( !overlay_graph || !( overlay_graph == graph.compact || ( overlay_graph->get_version() != 0 && overlay_graph->get_version() == graph.version ) ) )
+    throw std::runtime_error( "Weight overlay was made for a different version of the lane graph" );
+  return *overlay_graph;
+}
+
+} // namespace
 
 bool
 RoadGraph::add_connection( Connection connection )
@@ -27,13 +58,138 @@ RoadGraph::add_connection( Connection connection )
   to_predecessors[connection.to_id].insert( connection.from_id );
 
   all_connections.insert( connection );
+  version = next_version();
+  compact.reset();
+  hierarchy.reset();
+  landmarks.reset();
+
+  return true;
+}
+
+void
+RoadGraph::remove_lane( LaneID lane_id )
+{
+  version = next_version();
+  compact.reset();
+  hierarchy.reset();
+
+  auto erase_link = [&]( std::unordered_map<LaneID, std::unordered_set<LaneID>>& neighbor_map, LaneID key, LaneID neighbor ) {
+    auto it = neighbor_map.find( key );
+    if( it == neighbor_map.end() )
+      return;
+    it->second.erase( neighbor );
+    if( it->second.empty() )
+      neighbor_map.erase( it );
+  };
+
+  Connection query;
+
+  auto successors_it = to_successors.find( lane_id );
+  if( successors_it != to_successors.end() )
+  {
+    for( const auto& successor : successors_it->second )
+    {
+      query.from_id = lane_id;
+      query.to_id   = successor;
+      all_connections.erase( query );
+      erase_link( to_predecessors, successor, lane_id );
+    }
+    to_successors.erase( successors_it );
+  }
+
+  auto predecessors_it = to_predecessors.find( lane_id );
+  if( predecessors_it != to_predecessors.end() )
+  {
+    for( const auto& predecessor : predecessors_it->second )
+    {
+      query.from_id = predecessor;
+      query.to_id   = lane_id;
+      all_connections.erase( query );
+      erase_link( to_successors, predecessor, lane_id );
+    }
+    to_predecessors.erase( predecessors_it );
+  }
+}
 
+bool
+RoadGraph::set_weight( LaneID from_id, LaneID to_id, double weight )
+{
+  auto connection = find_connection( from_id, to_id );
+  if( !connection )
+    return false;
+
+  version = next_version();
+  compact.reset();
+  hierarchy.reset();
+  if( weight < connection->weight )
+    landmarks.reset();
+
+  all_connections.erase( *connection );
+  connection->weight = weight;
+  all_connections.insert( *connection );
   return true;
 }
 
+void
+RoadGraph::build_compact( const LaneStore* lanes )
+{
+  std::shared_ptr<CompactRoadGraph> graph;
+  if( lanes || !lane_positions )
+    graph = std::make_shared<CompactRoadGraph>( CompactRoadGraph::build( *this, lanes ) );
+  else
+    graph = std::make_shared<CompactRoadGraph>( CompactRoadGraph::build( *this, *lane_positions ) );
+
+  if( lanes )
+  {
+    auto recorded = graph->get_lane_positions();
+    if( !recorded.lane_ids.empty() )
+      lane_positions = std::make_shared<const LanePositions>( std::move( recorded ) );
+  }
+  if( landmarks )
+    graph->set_landmarks( landmarks );
+  compact = std::move( graph );
+}
+
+void
+RoadGraph::build_landmarks( const LandmarkConfig& config )
+{
+  if( !compact )
+    build_compact();
+  landmarks = std::make_shared<const LandmarkIndex>( LandmarkIndex::build( *compact, config ) );
+
+  // The compact graph is shared and immutable, so the landmarks go into a copy
+  auto graph = std::make_shared<CompactRoadGraph>( *compact );
+  graph->set_landmarks( landmarks );
+  compact = std::move( graph );
+}
+
+void
+RoadGraph::build_hierarchy( const ContractionConfig& config, const ContractionHierarchy* previous )
+{
+  if( !compact )
+    build_compact();
+  hierarchy = std::make_shared<const ContractionHierarchy>( ContractionHierarchy::build( *compact, config, previous ) );
+}
+
 std::deque<LaneID>
-RoadGraph::find_path( LaneID from, LaneID to, bool allow_reverse ) const
+RoadGraph::find_path( LaneID from, LaneID to, bool allow_reverse, const std::function<bool( LaneID )>& lane_filter ) const
 {
+  if( hierarchy && !lane_filter && hierarchy->allows_reverse() == allow_reverse )
+  {
+    auto path = hierarchy->find_path( from, to );
+    if( path.empty() )
+      std::cerr << "failed to find route to end" << std::endl;
+    return path;
+  }
+
+  if( compact )
+  {
+    auto path = compact->find_path( from, to, allow_reverse, lane_filter );
+    if( path.empty() )
+      std::cerr << "failed to find route to end" << std::endl;
+    return path;
+  }
+
   using QueueEntry = std::pair<double, LaneID>;
   std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> pq;
 
@@ -63,6 +219,9 @@ RoadGraph::find_path( LaneID from, LaneID to, bool allow_reverse ) const
 
       for( const auto& neighbor : neighbor_map.at( current_road ) )
       {
+        if( lane_filter && !lane_filter( neighbor ) )
+          continue;
+
         std::optional<Connection> conn;
         if( !reverse_direction )
           conn = find_connection( current_road, neighbor );
@@ -91,6 +250,118 @@ RoadGraph::find_path( LaneID from, LaneID to, bool allow_reverse ) const
   return {};
 }
 
+std::deque<LaneID>
+RoadGraph::find_path( LaneID from, LaneID to, bool allow_reverse, const WeightOverlay& overlay,
+                      const std::function<bool( LaneID )>& lane_filter ) const
+{
+  return get_overlay_graph( *this, overlay ).find_path( from, to, allow_reverse, lane_filter, &overlay );
+}
+
+std::deque<LaneID>
+RoadGraph::find_path( LaneID from, LaneID to, bool allow_reverse, const WeightOverlayHandle& overlays,
+                      const std::function<bool( LaneID )>& lane_filter ) const
+{
+  const auto overlay = overlays.get();
+  if( !overlay )
+    return find_path( from, to, allow_reverse, lane_filter );
+  return find_path( from, to, allow_reverse, *overlay, lane_filter );
+}
+
+std::deque<LaneID>
+RoadGraph::find_path_bidirectional( LaneID from, LaneID to, bool allow_reverse, const std::function<bool( LaneID )>& lane_filter,
+                                    const WeightOverlay* overlay ) const
+{
+  if( overlay )
+    return get_overlay_graph( *this, *overlay ).find_path_bidirectional( from, to, allow_reverse, lane_filter, overlay );
+  if( compact )
+    return compact->find_path_bidirectional( from, to, allow_reverse, lane_filter );
+  return find_path( from, to, allow_reverse, lane_filter );
+}
+
+std::vector<std::deque<LaneID>>
+RoadGraph::find_alternative_paths( LaneID from, LaneID to, const AlternativeRouteConfig& config, const WeightOverlay* overlay ) const
+{
+  if( overlay )
+    return get_overlay_graph( *this, *overlay ).find_alternative_paths( from, to, config, overlay );
+  if( !compact )
+    throw std::runtime_error( "find_alternative_paths needs a compact graph, call build_compact() first" );
+  return compact->find_alternative_paths( from, to, config );
+}
+
+ReachableSet
+RoadGraph::find_reachable( LaneID from, double max_cost, SearchDirection direction, bool allow_lane_changes,
+                           std::span<const LaneID> targets, const WeightOverlay* overlay ) const
+{
+  if( overlay )
+    return get_overlay_graph( *this, *overlay ).find_reachable( from, max_cost, direction, allow_lane_changes, targets, overlay );
+  if( compact )
+    return compact->find_reachable( from, max_cost, direction, allow_lane_changes, targets );
+
+  ReachableSet result;
+  result.direction = direction;
+  if( !( max_cost >= 0.0 ) )
+    return result;
+
+  // Targets in the graph, the search ends once all of them are settled
+  std::unordered_set<LaneID> targets_left;
+  for( const auto lane_id : targets )
+  {
+    if( to_successors.count( lane_id ) > 0 || to_predecessors.count( lane_id ) > 0 )
+      targets_left.insert( lane_id );
+  }
+  const bool has_targets = !targets_left.empty();
+
+  using QueueEntry = std::tuple<double, LaneID, LaneID>;
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> pq;
+  std::unordered_map<LaneID, double>                                       shortest_paths;
+
+  pq.push( { 0.0, from, from } );
+  shortest_paths[from] = 0.0;
+
+  while( !pq.empty() )
+  {
+    auto [current_cost, current_road, previous_road] = pq.top();
+    pq.pop();
+
+    if( result.index.find( current_road ) != result.index.end() )
+      continue;
+    result.index.emplace( current_road, result.lanes.size() );
+    result.lanes.push_back( { current_road, current_cost, previous_road } );
+    if( has_targets && targets_left.erase( current_road ) > 0 && targets_left.empty() )
+      break;
+
+    auto try_neighbors = [&]( const std::unordered_map<LaneID, std::unordered_set<LaneID>>& neighbor_map, bool reverse_direction ) {
+      auto neighbors_it = neighbor_map.find( current_road );
+      if( neighbors_it == neighbor_map.end() )
+        return;
+
+      for( const auto& neighbor : neighbors_it->second )
+      {
+        auto conn = reverse_direction ? find_connection( neighbor, current_road ) : find_connection( current_road, neighbor );
+        if( !conn || ( !allow_lane_changes && conn->connection_type == PARALLEL ) )
+          continue;
+
+        double new_cost = current_cost + conn->weight;
+        if( new_cost > max_cost || result.index.find( neighbor ) != result.index.end() )
+          continue;
+        auto cost_it = shortest_paths.find( neighbor );
+        if( cost_it == shortest_paths.end() || new_cost < cost_it->second )
+        {
+          shortest_paths[neighbor] = new_cost;
+          pq.push( { new_cost, neighbor, current_road } );
+        }
+      }
+    };
+
+    if( direction != BACKWARD )
+      try_neighbors( to_successors, false );
+    if( direction != FORWARD )
+      try_neighbors( to_predecessors, true );
+  }
+
+  return result;
+}
+
 std::deque<LaneID>
 RoadGraph::get_best_path( LaneID from, LaneID to ) const
 {
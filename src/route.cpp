@@ -13,13 +13,15 @@
 
 #include "adore_map/route.hpp"
 
+#include "adore_math/angles.h"
+
 namespace adore
 {
 namespace map
 {
 
 void
-Route::add_route_section( Border& lane_to_add, const MapPoint& start_point, const MapPoint& end_point, bool reverse /* = false */ )
+Route::add_route_section( const Border& lane_to_add, const MapPoint& start_point, const MapPoint& end_point, bool reverse /* = false */ )
 {
   if( lane_to_add.interpolated_points.empty() )
     return;
@@ -120,6 +122,35 @@ Route::get_curvature_at_s( double s ) const
   return curvature;
 }
 
+math::Pose2d
+Route::from_frenet( double s, double d ) const
+{
+  if( !map )
+    return math::Pose2d();
+
+  // Last section starting at or before s, the first one for s before the route start
+  std::shared_ptr<RouteSection> section;
+  for( const auto& candidate : sections )
+  {
+    if( candidate->start_s == candidate->end_s || !map->lanes.count( candidate->lane_id ) )
+      continue;
+    if( section && candidate->route_s > s )
+      break;
+    section = candidate;
+  }
+  if( !section )
+    return math::Pose2d();
+
+  const auto& lane = *map->lanes.at( section->lane_id );
+  if( section->start_s <= section->end_s )
+    return lane_frenet_to_pose( lane, section->start_s + ( s - section->route_s ), d );
+
+  // Sections driven against the lane point order
+  auto pose = lane_frenet_to_pose( lane, section->start_s - ( s - section->route_s ), -d );
+  pose.yaw  = math::normalize_angle( pose.yaw + M_PI );
+  return pose;
+}
+
 void
 Route::initialize_reference_line()
 {
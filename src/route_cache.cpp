@@ -0,0 +1,61 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+
+#include "adore_map/route_cache.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+RouteCache::RouteCache( size_t capacity ) :
+  cache( capacity, caches::LRUCachePolicy<RouteKey>() )
+{}
+
+std::deque<LaneID>
+RouteCache::find_path( const RoadGraph& graph, LaneID from, LaneID to, bool allow_reverse )
+{
+  const RouteKey key{ from, to, allow_reverse, graph.version };
+  if( auto [route, found] = cache.TryGet( key ); found )
+  {
+    ++hits;
+    return *route;
+  }
+
+  ++misses;
+  auto route = graph.find_path( from, to, allow_reverse );
+  cache.Put( key, route );
+  return route;
+}
+
+RouteCacheStats
+RouteCache::get_stats() const
+{
+  RouteCacheStats stats;
+  stats.hits   = hits;
+  stats.misses = misses;
+  stats.size   = cache.Size();
+  return stats;
+}
+
+void
+RouteCache::clear()
+{
+  cache.Clear();
+  hits   = 0;
+  misses = 0;
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,103 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/shared_map.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace adore
+{
+namespace map
+{
+
+void
+SharedMap::publish( const Map& map, const std::string& segment_name )
+{
+  const auto buffer = compile_map( map );
+
+  // A fresh segment is created instead of overwriting the old one in place, readers still attached to it stay valid.
+  // Between the unlink and the final magic store, attach fails and has to be retried (see SharedMap::attach)
+  ::shm_unlink( segment_name.c_str() );
+  int fd = ::shm_open( segment_name.c_str(), O_CREAT | O_EXCL | O_RDWR | O_CLOEXEC, 0644 );
+  if( fd < 0 )
+    throw std::runtime_error( "Failed to create shared map segment " + segment_name + ": " + std::strerror( errno ) );
+
+  if( ::ftruncate( fd, static_cast<off_t>( buffer.size() ) ) != 0 )
+  {
+    ::close( fd );
+    ::shm_unlink( segment_name.c_str() );
+    throw std::runtime_error( "Failed to size shared map segment " + segment_name + ": " + std::strerror( errno ) );
+  }
+
+  void* address = ::mmap( nullptr, buffer.size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+  ::close( fd );
+  if( address == MAP_FAILED )
+  {
+    ::shm_unlink( segment_name.c_str() );
+    throw std::runtime_error( "Failed to map shared map segment " + segment_name + ": " + std::strerror( errno ) );
+  }
+
+  // Copy everything but the magic first, so a reader attaching early rejects the segment instead of reading a partial map.
+  // The magic is then stored as one word with release semantics, paired with the acquire load in the CompiledMap constructor
+  auto*            bytes      = static_cast<std::byte*>( address );
+  constexpr size_t magic_size = sizeof( uint64_t );
+  static_assert( sizeof( compiled::MAGIC ) == magic_size );
+  std::memcpy( bytes + magic_size, buffer.data() + magic_size, buffer.size() - magic_size );
+  uint64_t magic;
+  std::memcpy( &magic, buffer.data(), magic_size );
+  std::atomic_ref<uint64_t>( *reinterpret_cast<uint64_t*>( bytes ) ).store( magic, std::memory_order_release );
+
+  ::munmap( address, buffer.size() );
+}
+
+CompiledMap
+SharedMap::attach( const std::string& segment_name )
+{
+  int fd = ::shm_open( segment_name.c_str(), O_RDONLY | O_CLOEXEC, 0 );
+  if( fd < 0 )
+    throw std::runtime_error( "Failed to open shared map segment " + segment_name + ": " + std::strerror( errno ) );
+
+  struct stat segment_stat;
+  if( ::fstat( fd, &segment_stat ) != 0 || segment_stat.st_size <= 0 )
+  {
+    ::close( fd );
+    throw std::runtime_error( "Shared map segment " + segment_name + " is empty" );
+  }
+
+  const size_t size    = static_cast<size_t>( segment_stat.st_size );
+  void*        address = ::mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, 0 );
+  ::close( fd );
+  if( address == MAP_FAILED )
+    throw std::runtime_error( "Failed to map shared map segment " + segment_name + ": " + std::strerror( errno ) );
+
+  std::shared_ptr<const void> mapping( address, [size]( const void* p ) { ::munmap( const_cast<void*>( p ), size ); } );
+  return CompiledMap( mapping, static_cast<const std::byte*>( address ), size );
+}
+
+bool
+SharedMap::remove( const std::string& segment_name )
+{
+  return ::shm_unlink( segment_name.c_str() ) == 0;
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,134 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include "adore_map/submap_tracker.hpp"
+
+namespace adore
+{
+namespace map
+{
+
+SubmapTracker::SubmapTracker( const std::shared_ptr<const Map>& parent_map, double width_, double height_ ) :
+  parent( parent_map ),
+  width( width_ ),
+  height( height_ )
+{
+  reset();
+}
+
+void
+SubmapTracker::reset()
+{
+  submap = Map();
+  if( !parent )
+    return;
+
+  // The submap index spans the whole parent map, so the window can move without re-rooting it
+  submap.quadtree.boundary = parent->quadtree.boundary;
+  submap.quadtree.capacity = parent->quadtree.capacity;
+}
+
+SubmapDelta
+SubmapTracker::update_window( const Boundary& new_window )
+{
+  SubmapDelta delta;
+  window = new_window;
+  if( !parent )
+    return delta;
+
+  const auto                 lane_ids_in_window = parent->get_lane_ids_in( window );
+  std::unordered_set<LaneID> lanes_in_window( lane_ids_in_window.begin(), lane_ids_in_window.end() );
+
+  for( const auto& [lane_id, lane] : submap.lanes )
+  {
+    if( lanes_in_window.find( lane_id ) == lanes_in_window.end() )
+      delta.removed_lane_ids.push_back( lane_id );
+  }
+
+  for( const auto& lane_id : lanes_in_window )
+  {
+    if( !submap.lanes.count( lane_id ) && parent->lanes.count( lane_id ) )
+      delta.added_lane_ids.push_back( lane_id );
+  }
+
+  std::sort( delta.removed_lane_ids.begin(), delta.removed_lane_ids.end() );
+  std::sort( delta.added_lane_ids.begin(), delta.added_lane_ids.end() );
+
+  for( const auto& lane_id : delta.removed_lane_ids )
+    remove_lane( lane_id );
+  for( const auto& lane_id : delta.added_lane_ids )
+    add_lane( lane_id );
+
+  return delta;
+}
+
+void
+SubmapTracker::add_lane( LaneID lane_id )
+{
+  const auto& lane = parent->lanes.at( lane_id );
+  submap.lanes.insert( lane );
+
+  for( const auto& point : lane->borders.center.interpolated_points )
+  {
+    submap.quadtree.insert( point );
+  }
+
+  auto road_it = parent->roads.find( lane->road_id );
+  if( road_it != parent->roads.end() )
+  {
+    auto submap_road_it = submap.roads.find( road_it->first );
+    if( submap_road_it == submap.roads.end() )
+    {
+      Road road = road_it->second;
+      road.lane_ids.clear();
+      submap_road_it = submap.roads.emplace( road_it->first, std::move( road ) ).first;
+    }
+    submap_road_it->second.add_lane( lane_id );
+  }
+
+  // Connect the lane to its neighbours that are already part of the submap
+  const auto& parent_graph = parent->lane_graph;
+
+  auto successors_it = parent_graph.to_successors.find( lane_id );
+  if( successors_it != parent_graph.to_successors.end() )
+  {
+    for( const auto& successor : successors_it->second )
+    {
+      if( !submap.lanes.count( successor ) )
+        continue;
+      if( auto connection = parent_graph.find_connection( lane_id, successor ) )
+        submap.lane_graph.add_connection( *connection );
+    }
+  }
+
+  auto predecessors_it = parent_graph.to_predecessors.find( lane_id );
+  if( predecessors_it != parent_graph.to_predecessors.end() )
+  {
+    for( const auto& predecessor : predecessors_it->second )
+    {
+      if( !submap.lanes.count( predecessor ) )
+        continue;
+      if( auto connection = parent_graph.find_connection( predecessor, lane_id ) )
+        submap.lane_graph.add_connection( *connection );
+    }
+  }
+}
+
+void
+SubmapTracker::remove_lane( LaneID lane_id )
+{
+  submap.remove_lane( lane_id );
+}
+
+} // namespace map
+} // namespace adore
@@ -0,0 +1,138 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+
+#include "adore_map/weight_overlay.hpp"
+
+#include <cmath>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace adore
+{
+namespace map
+{
+
+WeightOverlay::WeightOverlay( std::shared_ptr<const CompactRoadGraph> graph_ ) :
+  graph( std::move( graph_ ) )
+{
+  for( const auto& edge : graph->forward_edges )
+    along_forward.push_back( edge.weight );
+  for( const auto& edge : graph->reverse_edges )
+    along_reverse.push_back( edge.weight );
+  against_forward = along_forward;
+  against_reverse = along_reverse;
+}
+
+void
+WeightOverlay::set_edge_weight( NodeIndex from, uint32_t forward_index, bool along, double weight )
+{
+  ( along ? along_forward : against_forward )[forward_index] = weight;
+  lowered = lowered || weight < graph->forward_edges[forward_index].weight;
+
+  // Predecessors of a node are sorted by node like all edges of a node
+  const NodeIndex to           = graph->forward_edges[forward_index].target;
+  const auto      predecessors = graph->get_predecessors( to );
+  auto            it           = std::lower_bound( predecessors.begin(), predecessors.end(), from,
+                                                   []( const CompactEdge& edge, NodeIndex node ) { return edge.target < node; } );
+  ( along ? along_reverse : against_reverse )[graph->reverse_offsets[to] + ( it - predecessors.begin() )] = weight;
+}
+
+bool
+WeightOverlay::close_connection( LaneID from_id, LaneID to_id )
+{
+  const NodeIndex from = graph->find_node( from_id );
+  const NodeIndex to   = graph->find_node( to_id );
+  if( from == NO_NODE || to == NO_NODE )
+    return false;
+
+  const auto successors = graph->get_successors( from );
+  auto       it         = std::lower_bound( successors.begin(), successors.end(), to,
+                                            []( const CompactEdge& edge, NodeIndex node ) { return edge.target < node; } );
+  if( it == successors.end() || it->target != to )
+    return false;
+
+  const uint32_t index = graph->forward_offsets[from] + ( it - successors.begin() );
+  set_edge_weight( from, index, true, std::numeric_limits<double>::infinity() );
+  set_edge_weight( from, index, false, std::numeric_limits<double>::infinity() );
+  return true;
+}
+
+bool
+WeightOverlay::close_lane( LaneID lane_id )
+{
+  const NodeIndex node = graph->find_node( lane_id );
+  if( node == NO_NODE )
+    return false;
+
+  // Entering over a connection into the lane, or backwards over a connection out of it. Leaving the lane
+  // the same two ways stays open.
+  for( const auto& edge : graph->get_predecessors( node ) )
+  {
+    const NodeIndex from       = edge.target;
+    const auto      successors = graph->get_successors( from );
+    auto            it         = std::lower_bound( successors.begin(), successors.end(), node,
+                                                   []( const CompactEdge& successor, NodeIndex target ) { return successor.target < target; } );
+    set_edge_weight( from, graph->forward_offsets[from] + ( it - successors.begin() ), true, std::numeric_limits<double>::infinity() );
+  }
+  for( uint32_t index = graph->forward_offsets[node]; index < graph->forward_offsets[node + 1]; ++index )
+    set_edge_weight( node, index, false, std::numeric_limits<double>::infinity() );
+  return true;
+}
+
+bool
+WeightOverlay::scale_lane( LaneID lane_id, double factor )
+{
+  // Negative or NaN weights would break the searches, which rely on costs never decreasing along a path
+  if( !std::isfinite( factor ) || factor < 0.0 )
+    throw std::invalid_argument( "WeightOverlay: lane weight factor must be finite and not negative" );
+
+  const NodeIndex node = graph->find_node( lane_id );
+  if( node == NO_NODE )
+    return false;
+
+  for( uint32_t index = graph->forward_offsets[node]; index < graph->forward_offsets[node + 1]; ++index )
+  {
+    const auto& edge = graph->forward_edges[index];
+    if( edge.type == PARALLEL )
+      continue;
+    if( !std::isinf( along_forward[index] ) )
+      set_edge_weight( node, index, true, factor * edge.weight );
+    if( !std::isinf( against_forward[index] ) )
+      set_edge_weight( node, index, false, factor * edge.weight );
+  }
+  return true;
+}
+
+void
+WeightOverlay::restrict_lane_types( const LaneStore& lanes, const std::vector<LaneType>& types )
+{
+  for( const auto& [lane_id, lane] : lanes )
+  {
+    if( lane && std::find( types.begin(), types.end(), lane->type ) != types.end() )
+      close_lane( lane_id );
+  }
+}
+
+std::deque<LaneID>
+WeightOverlay::find_path( LaneID from, LaneID to, bool allow_reverse, const std::function<bool( LaneID )>& lane_filter ) const
+{
+  if( !graph )
+    return {};
+  return graph->find_path( from, to, allow_reverse, lane_filter, this );
+}
+
+} // namespace map
+} // namespace adore
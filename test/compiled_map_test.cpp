@@ -0,0 +1,345 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "adore_map/compiled_map.hpp"
+#include "adore_map/map.hpp"
+#include "adore_map/map_loader.hpp"
+#include "adore_map/shared_map.hpp"
+
+#ifndef ADORE_MAP_TEST_DATA_DIR
+  // Fallback – will be overridden from CMake for real tests.
+  #define ADORE_MAP_TEST_DATA_DIR "."
+#endif
+
+namespace
+{
+const adore::map::Map&
+load_test_map()
+{
+  static const adore::map::Map map = adore::map::MapLoader::load_from_file( std::string( ADORE_MAP_TEST_DATA_DIR ) + "/test_map.r2sr",
+                                                                            true );
+  return map;
+}
+
+void
+expect_same_points( const std::vector<adore::map::MapPoint>& expected, const std::vector<adore::map::MapPoint>& actual )
+{
+  ASSERT_EQ( expected.size(), actual.size() );
+  for( size_t i = 0; i < expected.size(); ++i )
+  {
+    EXPECT_EQ( expected[i].x, actual[i].x );
+    EXPECT_EQ( expected[i].y, actual[i].y );
+    EXPECT_EQ( expected[i].s, actual[i].s );
+    EXPECT_EQ( expected[i].parent_id, actual[i].parent_id );
+    EXPECT_EQ( expected[i].max_speed, actual[i].max_speed );
+  }
+}
+} // namespace
+
+// A map written to disk and memory mapped again is identical to the parsed one.
+TEST( CompiledMapTest, file_round_trip_preserves_map )
+{
+  const auto&       original = load_test_map();
+  const std::string file     = ::testing::TempDir() + "compiled_map_test.admap";
+  adore::map::write_compiled_map( original, file );
+
+  adore::map::Map loaded = adore::map::MapLoader::load_from_file( file );
+  std::remove( file.c_str() );
+
+  ASSERT_EQ( loaded.lanes.size(), original.lanes.size() );
+  for( const auto& [lane_id, lane] : original.lanes )
+  {
+    ASSERT_TRUE( loaded.lanes.count( lane_id ) ) << "Missing lane " << lane_id;
+    const auto& copy = loaded.lanes.at( lane_id );
+    EXPECT_EQ( copy->id, lane->id );
+    EXPECT_EQ( copy->road_id, lane->road_id );
+    EXPECT_EQ( copy->length, lane->length );
+    EXPECT_EQ( copy->speed_limit, lane->speed_limit );
+    EXPECT_EQ( copy->type, lane->type );
+    EXPECT_EQ( copy->material, lane->material );
+    EXPECT_EQ( copy->left_of_reference, lane->left_of_reference );
+
+    expect_same_points( lane->borders.inner.points, copy->borders.inner.points );
+    expect_same_points( lane->borders.outer.interpolated_points, copy->borders.outer.interpolated_points );
+    expect_same_points( lane->borders.center.interpolated_points, copy->borders.center.interpolated_points );
+
+    // Splines are restored from their coefficients and evaluate identically
+    ASSERT_EQ( lane->borders.inner.spline.has_value(), copy->borders.inner.spline.has_value() );
+    if( lane->borders.inner.spline )
+    {
+      const auto& spline = *lane->borders.inner.spline;
+      for( double s = 0.0; s <= spline.get_total_length(); s += 0.7 )
+      {
+        EXPECT_EQ( spline.get_point_at_s( s ), copy->borders.inner.spline->get_point_at_s( s ) );
+        EXPECT_EQ( spline.get_x_derivative_at_s( s ), copy->borders.inner.spline->get_x_derivative_at_s( s ) );
+      }
+    }
+  }
+
+  ASSERT_EQ( loaded.roads.size(), original.roads.size() );
+  for( const auto& [road_id, road] : original.roads )
+  {
+    const auto& copy = loaded.roads.at( road_id );
+    EXPECT_EQ( copy.name, road.name );
+    EXPECT_EQ( copy.category, road.category );
+    EXPECT_EQ( copy.one_way, road.one_way );
+    EXPECT_EQ( copy.lane_ids, road.lane_ids );
+  }
+
+  EXPECT_EQ( loaded.lane_graph.all_connections.size(), original.lane_graph.all_connections.size() );
+  for( const auto& connection : original.lane_graph.all_connections )
+  {
+    auto copy = loaded.lane_graph.find_connection( connection.from_id, connection.to_id );
+    ASSERT_TRUE( copy.has_value() );
+    EXPECT_EQ( copy->weight, connection.weight );
+    EXPECT_EQ( copy->connection_type, connection.connection_type );
+  }
+
+  // The restored spatial index answers queries like the original one
+  const auto& any_lane = original.lanes.begin()->second;
+  for( const auto& point : any_lane->borders.outer.interpolated_points )
+  {
+    double original_dist = std::numeric_limits<double>::max();
+    double loaded_dist   = std::numeric_limits<double>::max();
+    auto   expected      = original.quadtree.get_nearest_point( point, original_dist );
+    auto   actual        = loaded.quadtree.get_nearest_point( point, loaded_dist );
+    ASSERT_TRUE( expected && actual );
+    EXPECT_EQ( *expected, *actual );
+    EXPECT_EQ( original_dist, loaded_dist );
+  }
+
+  std::vector<adore::map::MapPoint> original_points, loaded_points;
+  original.quadtree.query( original.quadtree.boundary, original_points );
+  loaded.quadtree.query( loaded.quadtree.boundary, loaded_points );
+  EXPECT_EQ( original_points.size(), loaded_points.size() );
+}
+
+// Writing a compiled map over a file that is mapped leaves the mapping readable.
+TEST( CompiledMapTest, rewriting_keeps_open_mappings_valid )
+{
+  const auto&       original = load_test_map();
+  const std::string file     = ::testing::TempDir() + "compiled_map_rewrite_test.admap";
+  adore::map::write_compiled_map( original, file );
+  const auto mapped = adore::map::CompiledMap::open( file );
+
+  // A smaller map would leave the old mapping past the end of the file if it were rewritten in place
+  adore::map::write_compiled_map( adore::map::Map(), file );
+  EXPECT_EQ( adore::map::CompiledMap::open( file ).find_lane( original.lanes.begin()->first ), nullptr );
+  EXPECT_FALSE( std::filesystem::exists( file + ".tmp" ) );
+  std::remove( file.c_str() );
+
+  for( const auto& [lane_id, lane] : original.lanes )
+  {
+    const auto* record = mapped.find_lane( lane_id );
+    ASSERT_NE( record, nullptr );
+    EXPECT_EQ( mapped.get_points( record->center.interpolated_points ).size(), lane->borders.center.interpolated_points.size() );
+  }
+}
+
+// Compiling is deterministic, so compiled maps can be compared and cached by content.
+TEST( CompiledMapTest, compiling_is_deterministic )
+{
+  const auto& original = load_test_map();
+  const auto  first    = adore::map::compile_map( original );
+  const auto  second   = adore::map::compile_map( adore::map::CompiledMap::from_buffer( first ).to_map() );
+  EXPECT_EQ( first, second );
+}
+
+// Buffers that are not compatible compiled maps are rejected before any record is read.
+TEST( CompiledMapTest, rejects_invalid_buffers )
+{
+  auto buffer = adore::map::compile_map( load_test_map() );
+
+  auto corrupted = buffer;
+  corrupted[0]   = std::byte{ 'X' };
+  EXPECT_THROW( adore::map::CompiledMap::from_buffer( corrupted ), std::runtime_error );
+
+  adore::map::compiled::Header header;
+  auto                         wrong_version = buffer;
+  std::memcpy( &header, wrong_version.data(), sizeof( header ) );
+  header.version += 1;
+  std::memcpy( wrong_version.data(), &header, sizeof( header ) );
+  EXPECT_THROW( adore::map::CompiledMap::from_buffer( wrong_version ), std::runtime_error );
+
+  auto truncated = buffer;
+  truncated.resize( buffer.size() / 2 );
+  EXPECT_THROW( adore::map::CompiledMap::from_buffer( truncated ), std::runtime_error );
+
+  EXPECT_THROW( adore::map::CompiledMap::open( ::testing::TempDir() + "does_not_exist.admap" ), std::runtime_error );
+
+  // Records are edited in place through the section table of the header
+  std::memcpy( &header, buffer.data(), sizeof( header ) );
+  auto record_at = [&]( std::vector<std::byte>& bytes, adore::map::compiled::Section section, size_t index, size_t record_size ) {
+    return bytes.data() + header.sections[section].offset + index * record_size;
+  };
+
+  // A quadtree child pointing back to the root would make queries loop forever
+  ASSERT_GT( header.sections[adore::map::compiled::INDEX_NODES].count, 1u );
+  adore::map::compiled::IndexNodeRecord node;
+  auto                                  cyclic = buffer;
+  auto* root = record_at( cyclic, adore::map::compiled::INDEX_NODES, 0, sizeof( node ) );
+  std::memcpy( &node, root, sizeof( node ) );
+  ASSERT_NE( node.children[0], adore::map::compiled::NONE );
+  const auto child_index = node.children[1];
+  auto*      child       = record_at( cyclic, adore::map::compiled::INDEX_NODES, child_index, sizeof( node ) );
+  std::memcpy( &node, child, sizeof( node ) );
+  node.children[0] = node.children[1] = node.children[2] = node.children[3] = 0;
+  std::memcpy( child, &node, sizeof( node ) );
+  EXPECT_THROW( adore::map::CompiledMap::from_buffer( cyclic ), std::runtime_error );
+
+  // Unsorted lanes would make find_lane miss lanes
+  ASSERT_GT( header.sections[adore::map::compiled::LANES].count, 1u );
+  adore::map::compiled::LaneRecord first_lane, second_lane;
+  auto                             unsorted = buffer;
+  auto* first  = record_at( unsorted, adore::map::compiled::LANES, 0, sizeof( first_lane ) );
+  auto* second = record_at( unsorted, adore::map::compiled::LANES, 1, sizeof( first_lane ) );
+  std::memcpy( &first_lane, first, sizeof( first_lane ) );
+  std::memcpy( &second_lane, second, sizeof( second_lane ) );
+  std::memcpy( first, &second_lane, sizeof( second_lane ) );
+  std::memcpy( second, &first_lane, sizeof( first_lane ) );
+  EXPECT_THROW( adore::map::CompiledMap::from_buffer( unsorted ), std::runtime_error );
+
+  // A segment count for which 9 * n + 3 wraps around to a small number must not pass the range check
+  const size_t spline_count = header.sections[adore::map::compiled::SPLINES].count;
+  ASSERT_GT( spline_count, 0u );
+  adore::map::compiled::SplineRecord spline;
+  auto                               wrapping = buffer;
+  for( size_t i = 0; i < spline_count; ++i )
+  {
+    auto* record = record_at( wrapping, adore::map::compiled::SPLINES, i, sizeof( spline ) );
+    std::memcpy( &spline, record, sizeof( spline ) );
+    spline.first_value   = 0;
+    spline.segment_count = ( std::numeric_limits<uint64_t>::max() - 6 ) / 9 + 1;
+    ASSERT_EQ( 9 * spline.segment_count + 3, 5u );
+    std::memcpy( record, &spline, sizeof( spline ) );
+  }
+  const auto wrapped = adore::map::CompiledMap::from_buffer( wrapping );
+  const auto lane_it = std::find_if( load_test_map().lanes.begin(), load_test_map().lanes.end(),
+                                     []( const auto& entry ) { return entry.second->borders.inner.spline.has_value(); } );
+  ASSERT_NE( lane_it, load_test_map().lanes.end() );
+  EXPECT_THROW( wrapped.make_lane( lane_it->first ), std::runtime_error );
+}
+
+// Queries on the compiled records agree with the same queries on the Map they were compiled from.
+TEST( CompiledMapTest, in_place_queries_match_map )
+{
+  const auto& original = load_test_map();
+  const auto  compiled = adore::map::CompiledMap::from_buffer( adore::map::compile_map( original ) );
+
+  for( const auto& [lane_id, lane] : original.lanes )
+  {
+    const auto* record = compiled.find_lane( lane_id );
+    ASSERT_NE( record, nullptr );
+    EXPECT_EQ( record->road_id, lane->road_id );
+    EXPECT_EQ( compiled.get_points( record->center.interpolated_points ).size(), lane->borders.center.interpolated_points.size() );
+    EXPECT_EQ( compiled.make_lane( lane_id )->length, lane->length );
+
+    auto expected_successors = original.lane_graph.to_successors.count( lane_id ) ? original.lane_graph.to_successors.at( lane_id )
+                                                                                   : std::unordered_set<size_t>{};
+    std::unordered_set<size_t> successors;
+    for( const auto& connection : compiled.get_successors( lane_id ) )
+      successors.insert( connection.to_id );
+    EXPECT_EQ( successors, expected_successors );
+
+    auto expected_predecessors = original.lane_graph.to_predecessors.count( lane_id ) ? original.lane_graph.to_predecessors.at( lane_id )
+                                                                                       : std::unordered_set<size_t>{};
+    std::unordered_set<size_t> predecessors;
+    for( const auto* connection : compiled.get_predecessors( lane_id ) )
+      predecessors.insert( connection->from_id );
+    EXPECT_EQ( predecessors, expected_predecessors );
+  }
+  EXPECT_EQ( compiled.find_lane( std::numeric_limits<size_t>::max() ), nullptr );
+
+  // Nearest point and window queries
+  for( const auto& [lane_id, lane] : original.lanes )
+  {
+    const auto& point         = lane->borders.inner.interpolated_points.front();
+    double      original_dist = std::numeric_limits<double>::max();
+    double      compiled_dist = std::numeric_limits<double>::max();
+    auto        expected      = original.quadtree.get_nearest_point( point, original_dist );
+    auto        actual        = compiled.get_nearest_point( point, compiled_dist );
+    ASSERT_TRUE( expected && actual );
+    EXPECT_EQ( *expected, *actual );
+    EXPECT_DOUBLE_EQ( original_dist, compiled_dist );
+
+    adore::map::CompiledMap::Boundary window{ point.x - 40.0, point.x + 40.0, point.y - 40.0, point.y + 40.0 };
+    EXPECT_EQ( compiled.get_lane_ids_in( window ), original.get_lane_ids_in( window ) );
+  }
+
+  // Routing yields paths of the same cost as the lane graph
+  auto path_cost = [&]( const std::deque<size_t>& path ) {
+    double cost = 0.0;
+    for( size_t i = 1; i < path.size(); ++i )
+    {
+      auto connection = original.lane_graph.find_connection( path[i - 1], path[i] );
+      if( !connection )
+        connection = original.lane_graph.find_connection( path[i], path[i - 1] );
+      cost += connection ? connection->weight : std::numeric_limits<double>::infinity();
+    }
+    return cost;
+  };
+  const size_t from = original.lanes.begin()->first;
+  for( const auto& [to, lane] : original.lanes )
+  {
+    auto expected = original.lane_graph.find_path( from, to, true );
+    auto actual   = compiled.find_path( from, to, true );
+    ASSERT_EQ( expected.empty(), actual.empty() ) << "to " << to;
+    if( !expected.empty() )
+    {
+      EXPECT_EQ( actual.front(), from );
+      EXPECT_EQ( actual.back(), to );
+      EXPECT_NEAR( path_cost( actual ), path_cost( expected ), 1e-9 );
+    }
+  }
+}
+
+// A published map can be attached from shared memory and queried without copying it.
+TEST( CompiledMapTest, shared_memory_publish_and_attach )
+{
+  const auto&       original = load_test_map();
+  const std::string segment  = "/adore_map_test_" + std::to_string( ::getpid() );
+
+  adore::map::SharedMap::publish( original, segment );
+  {
+    const auto attached = adore::map::SharedMap::attach( segment );
+    EXPECT_EQ( attached.lanes().size(), original.lanes.size() );
+    EXPECT_EQ( attached.connections().size(), original.lane_graph.all_connections.size() );
+
+    // Removing the name does not invalidate an existing attachment
+    EXPECT_TRUE( adore::map::SharedMap::remove( segment ) );
+    const auto& point    = original.lanes.begin()->second->borders.center.interpolated_points.front();
+    double      min_dist = std::numeric_limits<double>::max();
+    auto        nearest  = attached.get_nearest_point( point, min_dist );
+    ASSERT_TRUE( nearest.has_value() );
+    EXPECT_NEAR( min_dist, 0.0, 1e-9 );
+  }
+
+  EXPECT_FALSE( adore::map::SharedMap::remove( segment ) );
+  EXPECT_THROW( adore::map::SharedMap::attach( segment ), std::runtime_error );
+}
@@ -0,0 +1,220 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "adore_map/map.hpp"
+#include "adore_map/map_handle.hpp"
+#include "adore_map/map_loader.hpp"
+#include "adore_map/parallel.hpp"
+#include "adore_map/route.hpp"
+
+#ifndef ADORE_MAP_TEST_DATA_DIR
+  // Fallback – will be overridden from CMake for real tests.
+  #define ADORE_MAP_TEST_DATA_DIR "."
+#endif
+
+namespace
+{
+std::shared_ptr<const adore::map::Map>
+load_test_map()
+{
+  static const auto map = std::make_shared<const adore::map::Map>(
+    adore::map::MapLoader::load_from_file( std::string( ADORE_MAP_TEST_DATA_DIR ) + "/test_map.r2sr", true ) );
+  return map;
+}
+
+size_t
+count_points( const adore::map::Map& map )
+{
+  std::vector<adore::map::MapPoint> points;
+  map.quadtree.query( map.quadtree.boundary, points );
+  return points.size();
+}
+} // namespace
+
+// Modifying a copy of a map never changes the map it was copied from.
+TEST( MapConcurrencyTest, map_copies_are_independent )
+{
+  const auto      original        = load_test_map();
+  const size_t    original_points = count_points( *original );
+  adore::map::Map copy            = *original;
+
+  const auto lane_id = copy.lanes.begin()->first;
+  ASSERT_TRUE( copy.remove_lane( lane_id ) );
+
+  EXPECT_EQ( count_points( *original ), original_points );
+  EXPECT_EQ( count_points( copy ), original_points - original->lanes.at( lane_id )->borders.center.interpolated_points.size() );
+  EXPECT_TRUE( original->lanes.count( lane_id ) );
+  EXPECT_TRUE( original->lane_graph.to_successors.count( lane_id ) || original->lane_graph.to_predecessors.count( lane_id ) );
+}
+
+// An update publishes a new version that shares unchanged lanes, while older snapshots stay intact.
+TEST( MapConcurrencyTest, handle_update_shares_lanes_and_keeps_old_snapshots )
+{
+  adore::map::MapHandle handle( load_test_map() );
+  const auto            before = handle.snapshot();
+
+  const auto removed_id = before.map->lanes.begin()->first;
+  auto       after      = handle.update( [&]( adore::map::Map& map ) { map.remove_lane( removed_id ); } );
+
+  EXPECT_EQ( after.version, before.version + 1 );
+  EXPECT_EQ( handle.get_version(), after.version );
+  EXPECT_EQ( handle.get().get(), after.map.get() );
+
+  EXPECT_TRUE( before.map->lanes.count( removed_id ) );
+  EXPECT_FALSE( after.map->lanes.count( removed_id ) );
+  EXPECT_EQ( after.map->lanes.size() + 1, before.map->lanes.size() );
+
+  for( const auto& [lane_id, lane] : after.map->lanes )
+  {
+    EXPECT_EQ( lane.get(), before.map->lanes.at( lane_id ).get() ) << "Unchanged lane " << lane_id << " should be shared";
+  }
+
+  // Nearest point queries on the old snapshot still find the removed lane
+  const auto& point    = before.map->lanes.at( removed_id )->borders.center.interpolated_points.front();
+  double      min_dist = std::numeric_limits<double>::max();
+  auto        nearest  = before.map->quadtree.get_nearest_point( point, min_dist );
+  ASSERT_TRUE( nearest.has_value() );
+  EXPECT_DOUBLE_EQ( min_dist, 0.0 );
+
+  min_dist = std::numeric_limits<double>::max();
+  nearest  = after.map->quadtree.get_nearest_point( point, min_dist );
+  ASSERT_TRUE( nearest.has_value() );
+  EXPECT_NE( nearest->parent_id, removed_id );
+}
+
+// Readers keep querying consistent snapshots while a writer removes and re-adds lanes.
+TEST( MapConcurrencyTest, readers_see_consistent_versions_during_updates )
+{
+  const auto            original = load_test_map();
+  adore::map::MapHandle handle( original );
+
+  std::vector<adore::map::LaneID> lane_ids;
+  for( const auto& [lane_id, lane] : original->lanes )
+    lane_ids.push_back( lane_id );
+
+  std::atomic<bool>   stop{ false };
+  std::atomic<size_t> inconsistencies{ 0 };
+  std::atomic<size_t> queries{ 0 };
+
+  std::vector<std::thread> readers;
+  for( size_t r = 0; r < 4; ++r )
+  {
+    readers.emplace_back( [&, r]() {
+      size_t i = r;
+      while( !stop.load() )
+      {
+        const auto  snapshot = handle.snapshot();
+        const auto& lane     = original->lanes.at( lane_ids[i++ % lane_ids.size()] );
+        const auto& point    = lane->borders.outer.interpolated_points.front();
+
+        double min_dist = std::numeric_limits<double>::max();
+        auto   nearest  = snapshot.map->quadtree.get_nearest_point( point, min_dist );
+
+        // Every indexed point of a version must belong to a lane of that same version
+        if( nearest && !snapshot.map->lanes.count( nearest->parent_id ) )
+          ++inconsistencies;
+        ++queries;
+      }
+    } );
+  }
+
+  for( size_t i = 0; i < 50; ++i )
+  {
+    const auto lane_id = lane_ids[i % lane_ids.size()];
+    handle.update( [&]( adore::map::Map& map ) { map.remove_lane( lane_id ); } );
+    handle.update( [&]( adore::map::Map& map ) { map.insert_lane( original->lanes.at( lane_id ) ); } );
+  }
+
+  stop = true;
+  for( auto& reader : readers )
+    reader.join();
+
+  EXPECT_EQ( inconsistencies.load(), 0u );
+  EXPECT_GT( queries.load(), 0u );
+  EXPECT_EQ( handle.get_version(), 100u );
+  EXPECT_EQ( handle.get()->lanes.size(), original->lanes.size() );
+  EXPECT_EQ( count_points( *handle.get() ), count_points( *original ) );
+}
+
+// Mixed nearest point, width, on-road and routing queries from a thread pool give the same results as
+// running them one after another. Run with ADORE_MAP_ENABLE_TSAN to check the const API for data races.
+TEST( MapConcurrencyTest, concurrent_const_queries_match_serial_results )
+{
+  const std::shared_ptr<const adore::map::Map> map = load_test_map();
+
+  std::vector<adore::map::MapPoint> query_points;
+  for( const auto& [lane_id, lane] : map->lanes )
+  {
+    for( const auto& point : lane->borders.outer.interpolated_points )
+      query_points.push_back( point );
+  }
+  const auto& destination = query_points[query_points.size() / 2];
+
+  struct Result
+  {
+    size_t                nearest_lane = 0;
+    double                nearest_dist = 0.0;
+    std::optional<double> width;
+    bool                  on_road      = false;
+    double                route_length = 0.0;
+    double                map_distance = 0.0;
+  };
+
+  auto run_query = [&]( size_t i ) {
+    const auto& point = query_points[i];
+    Result      result;
+
+    double min_dist = std::numeric_limits<double>::max();
+    auto   nearest  = map->quadtree.get_nearest_point( point, min_dist );
+    if( nearest )
+    {
+      result.nearest_lane = nearest->parent_id;
+      result.nearest_dist = min_dist;
+      result.map_distance = adore::map::get_map_distance( *nearest, destination, map );
+    }
+    result.width   = map->get_nearest_lane_width( point );
+    result.on_road = map->is_point_on_road( point );
+
+    // Routes are comparatively expensive, only build every few queries
+    if( i % 16 == 0 )
+      result.route_length = adore::map::Route( point, destination, map ).get_length();
+    return result;
+  };
+
+  std::vector<Result> serial( query_points.size() );
+  for( size_t i = 0; i < query_points.size(); ++i )
+    serial[i] = run_query( i );
+
+  std::vector<Result> parallel( query_points.size() );
+  adore::map::parallel_for( query_points.size(), 8, [&]( size_t i ) { parallel[i] = run_query( i ); } );
+
+  for( size_t i = 0; i < query_points.size(); ++i )
+  {
+    EXPECT_EQ( parallel[i].nearest_lane, serial[i].nearest_lane );
+    EXPECT_EQ( parallel[i].nearest_dist, serial[i].nearest_dist );
+    EXPECT_EQ( parallel[i].width, serial[i].width );
+    EXPECT_EQ( parallel[i].on_road, serial[i].on_road );
+    EXPECT_EQ( parallel[i].route_length, serial[i].route_length );
+    EXPECT_EQ( parallel[i].map_distance, serial[i].map_distance );
+  }
+}
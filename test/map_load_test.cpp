@@ -13,11 +13,13 @@
 
 #include <gtest/gtest.h>
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "adore_map/lane.hpp"
+#include "adore_map/lane_store.hpp"
 #include "adore_map/map.hpp"
 #include "adore_map/map_loader.hpp"
 #include "adore_map/road_graph.hpp"
@@ -106,3 +108,90 @@ TEST( MapTest, quadtree_contains_points_from_lanes )
 
   EXPECT_FALSE( found.empty() ) << "Quadtree query around a lane center point returned no points";
 }
+
+// Lanes are stored densely: every lane id resolves to a slot in [0, size()) and every road lane id resolves to a lane.
+TEST( MapTest, lane_store_indices_are_dense_and_roads_resolve )
+{
+  const std::string map_file = get_test_map_r2s_path();
+  adore::map::Map   map      = adore::map::MapLoader::load_from_file( map_file, false );
+
+  std::vector<bool> slot_used( map.lanes.size(), false );
+  for( const auto& [lane_id, lane] : map.lanes )
+  {
+    ASSERT_TRUE( lane );
+    EXPECT_EQ( lane_id, lane->id );
+
+    const uint32_t index = map.lanes.index_of( lane_id );
+    ASSERT_LT( index, map.lanes.size() );
+    EXPECT_FALSE( slot_used[index] ) << "Two lanes share dense index " << index;
+    slot_used[index] = true;
+    EXPECT_EQ( map.lanes.at_index( index ).second, lane );
+  }
+
+  for( const auto& [road_id, road] : map.roads )
+  {
+    for( auto lane_id : road.lane_ids )
+    {
+      ASSERT_TRUE( map.lanes.count( lane_id ) > 0 ) << "Road " << road_id << " references missing lane " << lane_id;
+      EXPECT_EQ( map.lanes.at( lane_id )->road_id, road_id );
+    }
+  }
+}
+
+// Lanes with huge ids are kept out of the direct-address table and still found, also after erasing others
+TEST( MapTest, lane_store_handles_sparse_ids )
+{
+  adore::map::LaneStore lanes;
+  for( const size_t lane_id : { size_t( 1 ), size_t( 1000000000 ), size_t( 2 ), std::numeric_limits<size_t>::max() - 1, size_t( 3 ) } )
+  {
+    auto lane = std::make_shared<adore::map::Lane>();
+    lane->id  = lane_id;
+    EXPECT_TRUE( lanes.insert( lane ).second );
+  }
+
+  ASSERT_EQ( lanes.size(), 5u );
+  for( const auto& [lane_id, lane] : lanes )
+  {
+    EXPECT_EQ( lanes.at( lane_id ), lane );
+    EXPECT_EQ( lanes.at_index( lanes.index_of( lane_id ) ).first, lane_id );
+  }
+  EXPECT_EQ( lanes.count( 999999999 ), 0u );
+
+  EXPECT_EQ( lanes.erase( 1 ), 1u );
+  EXPECT_EQ( lanes.erase( 1000000000 ), 1u );
+  EXPECT_EQ( lanes.count( 1000000000 ), 0u );
+  ASSERT_EQ( lanes.size(), 3u );
+  for( const auto& [lane_id, lane] : lanes )
+    EXPECT_EQ( lanes.at( lane_id ), lane );
+}
+
+// Lane ids are assigned per load, so loading the same map twice yields identical ids for identical lanes.
+TEST( MapTest, lane_ids_are_stable_across_reloads )
+{
+  const std::string map_file = get_test_map_r2s_path();
+  adore::map::Map   first    = adore::map::MapLoader::load_from_file( map_file, false );
+  adore::map::Map   second   = adore::map::MapLoader::load_from_file( map_file, false );
+
+  ASSERT_EQ( first.lanes.size(), second.lanes.size() );
+  for( const auto& [lane_id, lane] : first.lanes )
+  {
+    ASSERT_TRUE( second.lanes.count( lane_id ) > 0 ) << "Lane " << lane_id << " missing after reload";
+    const auto& reloaded = second.lanes.at( lane_id );
+    EXPECT_EQ( lane->road_id, reloaded->road_id );
+
+    const auto& points          = lane->borders.center.interpolated_points;
+    const auto& reloaded_points = reloaded->borders.center.interpolated_points;
+    ASSERT_EQ( points.size(), reloaded_points.size() );
+    if( !points.empty() )
+    {
+      EXPECT_DOUBLE_EQ( points.front().x, reloaded_points.front().x );
+      EXPECT_DOUBLE_EQ( points.front().y, reloaded_points.front().y );
+    }
+  }
+
+  EXPECT_EQ( first.lane_graph.all_connections.size(), second.lane_graph.all_connections.size() );
+  for( const auto& connection : first.lane_graph.all_connections )
+  {
+    EXPECT_TRUE( second.lane_graph.find_connection( connection.from_id, connection.to_id ).has_value() );
+  }
+}
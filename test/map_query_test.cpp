@@ -0,0 +1,538 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "adore_map/boundary_index.hpp"
+#include "adore_map/distance_field.hpp"
+#include "adore_map/frenet.hpp"
+#include "adore_map/lane_polygons.hpp"
+#include "adore_map/map.hpp"
+#include "adore_map/map_association.hpp"
+#include "adore_map/map_loader.hpp"
+#include "adore_map/rasterizer.hpp"
+#include "adore_map/route.hpp"
+#include "adore_math/pose.h"
+
+#ifndef ADORE_MAP_TEST_DATA_DIR
+  // Fallback – will be overridden from CMake for real tests.
+  #define ADORE_MAP_TEST_DATA_DIR "."
+#endif
+
+namespace
+{
+std::shared_ptr<const adore::map::Map>
+load_test_map()
+{
+  static const auto map = std::make_shared<const adore::map::Map>(
+    adore::map::MapLoader::load_from_file( std::string( ADORE_MAP_TEST_DATA_DIR ) + "/test_map.r2sr", true ) );
+  return map;
+}
+
+// Poses in the middle of every lane, pointing in its driving direction and shifted sideways by offset
+std::vector<adore::math::Pose2d>
+get_lane_poses( const adore::map::Map& map, double offset, std::vector<adore::map::LaneID>* lane_ids = nullptr )
+{
+  std::vector<adore::math::Pose2d> poses;
+  for( const auto& [lane_id, lane] : map.lanes )
+  {
+    const auto& points = lane->borders.center.interpolated_points;
+    if( points.size() < 3 )
+      continue;
+
+    const auto& a   = points[points.size() / 2];
+    const auto& b   = points[points.size() / 2 + 1];
+    double      yaw = std::atan2( b.y - a.y, b.x - a.x ) + ( lane->left_of_reference ? M_PI : 0.0 );
+
+    adore::math::Pose2d pose;
+    pose.x   = 0.5 * ( a.x + b.x ) - offset * std::sin( yaw );
+    pose.y   = 0.5 * ( a.y + b.y ) + offset * std::cos( yaw );
+    pose.yaw = yaw;
+    poses.push_back( pose );
+    if( lane_ids )
+      lane_ids->push_back( lane_id );
+  }
+  return poses;
+}
+} // namespace
+
+// A batch association agrees with the separate width and on-road queries and does not depend on threading.
+TEST( MapQueryTest, batch_association_matches_single_queries )
+{
+  const auto map   = load_test_map();
+  const auto poses = get_lane_poses( *map, 0.4 );
+  ASSERT_FALSE( poses.empty() );
+
+  const auto serial   = adore::map::associate_poses( *map, poses );
+  const auto parallel = adore::map::associate_poses( *map, poses, 4 );
+  ASSERT_EQ( serial.size(), poses.size() );
+  ASSERT_EQ( parallel.size(), poses.size() );
+
+  for( size_t i = 0; i < poses.size(); ++i )
+  {
+    const auto& association = serial[i];
+    ASSERT_TRUE( association.found );
+
+    EXPECT_EQ( association.lane_width, map->get_nearest_lane_width( poses[i] ).value() );
+    EXPECT_EQ( association.on_road, map->is_point_on_road( poses[i] ) );
+
+    EXPECT_EQ( parallel[i].lane_id, association.lane_id );
+    EXPECT_EQ( parallel[i].s, association.s );
+    EXPECT_EQ( parallel[i].lateral_offset, association.lateral_offset );
+  }
+}
+
+// Lateral offsets are signed towards the left of the driving direction and headings follow the lane.
+TEST( MapQueryTest, association_offset_and_heading_follow_driving_direction )
+{
+  const auto                      map = load_test_map();
+  std::vector<adore::map::LaneID> lane_ids;
+  const auto                      left_poses  = get_lane_poses( *map, 0.3, &lane_ids );
+  const auto                      right_poses = get_lane_poses( *map, -0.3 );
+
+  const auto left_associations  = adore::map::associate_poses( *map, left_poses );
+  const auto right_associations = adore::map::associate_poses( *map, right_poses );
+
+  size_t checked = 0;
+  for( size_t i = 0; i < left_poses.size(); ++i )
+  {
+    // Only judge poses associated with the lane they were generated from, lanes overlap at junctions
+    if( left_associations[i].lane_id != lane_ids[i] || right_associations[i].lane_id != lane_ids[i] )
+      continue;
+
+    // The poses are offset from the center polyline, the continuous center line deviates slightly on curves
+    EXPECT_NEAR( left_associations[i].lateral_offset, 0.3, 0.05 );
+    EXPECT_NEAR( right_associations[i].lateral_offset, -0.3, 0.05 );
+    EXPECT_NEAR( left_associations[i].heading_difference, 0.0, 0.1 );
+    // Offsets normal to a polyline segment land at slightly different s on the curved center line
+    EXPECT_NEAR( right_associations[i].s, left_associations[i].s, 0.15 );
+
+    // Same projection as the Frenet conversion, only the sign follows the driving direction
+    const auto frenet = map->to_frenet( left_poses[i] );
+    ASSERT_TRUE( frenet );
+    const bool against_s = map->lanes.at( lane_ids[i] )->left_of_reference;
+    EXPECT_DOUBLE_EQ( left_associations[i].s, frenet->s );
+    EXPECT_DOUBLE_EQ( left_associations[i].lateral_offset, against_s ? -frenet->d : frenet->d );
+    ++checked;
+  }
+  EXPECT_GT( checked, left_poses.size() / 2 );
+}
+
+// The continuous center line passes through every center point and Frenet conversions invert each other.
+TEST( MapQueryTest, frenet_round_trip_on_lane_center_lines )
+{
+  const auto map               = load_test_map();
+  size_t     conversions       = 0;
+  size_t     exact_round_trips = 0;
+  for( const auto& [lane_id, lane] : map->lanes )
+  {
+    const auto& points = lane->borders.center.interpolated_points;
+    for( const auto& point : points )
+    {
+      const auto sample = adore::map::evaluate_center_line( *lane, point.s );
+      EXPECT_NEAR( sample.x, point.x, 1e-9 );
+      EXPECT_NEAR( sample.y, point.y, 1e-9 );
+    }
+
+    // Stay off the lane ends, where s is clamped
+    for( size_t i = 1; i + 1 < points.size(); i += 3 )
+    {
+      const double s = 0.5 * ( points[i].s + points[i + 1].s );
+      for( double d : { -0.8, 0.0, 0.6 } )
+      {
+        const auto pose = map->from_frenet( { lane_id, s, d } );
+        ASSERT_TRUE( pose.has_value() );
+
+        // Start from the nearest center sample, like Map::to_frenet
+        const auto nearest = std::min_element( points.begin(), points.end(), [&]( const auto& a, const auto& b ) {
+          return std::hypot( a.x - pose->x, a.y - pose->y ) < std::hypot( b.x - pose->x, b.y - pose->y );
+        } );
+
+        const auto frenet = adore::map::project_onto_lane( *lane, pose->x, pose->y, nearest->s );
+        EXPECT_EQ( frenet.lane_id, lane_id );
+        EXPECT_LE( std::fabs( frenet.d ), std::hypot( nearest->x - pose->x, nearest->y - pose->y ) + 1e-9 );
+        ++conversions;
+
+        // Where the borders have corners tighter than the offset another foot point can be found
+        if( std::fabs( frenet.s - s ) < 1e-6 && std::fabs( frenet.d - d ) < 1e-6 )
+          ++exact_round_trips;
+
+        // Interior projections are perpendicular, so converting back gives the same point
+        if( frenet.s <= points.front().s || frenet.s >= points.back().s )
+          continue;
+        const auto back = map->from_frenet( frenet );
+        EXPECT_NEAR( back->x, pose->x, 1e-6 );
+        EXPECT_NEAR( back->y, pose->y, 1e-6 );
+      }
+    }
+  }
+  EXPECT_GT( exact_round_trips, conversions * 95 / 100 );
+
+  EXPECT_FALSE( map->from_frenet( { std::numeric_limits<adore::map::LaneID>::max(), 0.0, 0.0 } ).has_value() );
+}
+
+// Map level projections agree with the batch variant and the distance to the nearest center line.
+TEST( MapQueryTest, frenet_batch_matches_single_projections )
+{
+  const auto map   = load_test_map();
+  const auto poses = get_lane_poses( *map, 0.4 );
+
+  const auto batch = map->to_frenet_batch( poses, 4 );
+  ASSERT_EQ( batch.size(), poses.size() );
+  for( size_t i = 0; i < poses.size(); ++i )
+  {
+    const auto single = map->to_frenet( poses[i] );
+    ASSERT_TRUE( single.has_value() );
+    ASSERT_TRUE( batch[i].has_value() );
+    EXPECT_EQ( batch[i]->lane_id, single->lane_id );
+    EXPECT_EQ( batch[i]->s, single->s );
+    EXPECT_EQ( batch[i]->d, single->d );
+    EXPECT_DOUBLE_EQ( map->get_distance_from_nearest_center( poses[i] ), std::fabs( single->d ) );
+
+    // The exact projection is never further away than the nearest center point
+    double min_dist = std::numeric_limits<double>::max();
+    map->quadtree.get_nearest_point( poses[i], min_dist );
+    EXPECT_LE( std::fabs( single->d ), min_dist + 1e-9 );
+  }
+}
+
+// Route Frenet coordinates follow the driving direction and invert each other.
+TEST( MapQueryTest, route_frenet_round_trip )
+{
+  const auto  map    = load_test_map();
+  const auto& lane   = map->lanes.begin()->second;
+  const auto& points = lane->borders.center.interpolated_points;
+
+  std::optional<adore::map::Route> route;
+  for( const auto& [lane_id, candidate] : map->lanes )
+  {
+    adore::map::Route candidate_route( points.front(), candidate->borders.center.interpolated_points.back(), map );
+    if( candidate_route.get_length() > 100.0 )
+    {
+      route = candidate_route;
+      break;
+    }
+  }
+  ASSERT_TRUE( route.has_value() );
+
+  size_t checked = 0;
+  for( double s = 5.0; s < route->get_length() - 5.0; s += 2.5 )
+  {
+    const auto center = route->from_frenet( s, 0.0 );
+    const auto left   = route->from_frenet( s, 0.5 );
+
+    // Positive offsets are to the left of the driving direction
+    const double cross = std::cos( center.yaw ) * ( left.y - center.y ) - std::sin( center.yaw ) * ( left.x - center.x );
+    EXPECT_NEAR( cross, 0.5, 1e-6 );
+
+    const auto frenet = route->to_frenet( left );
+    ASSERT_TRUE( frenet.has_value() );
+
+    // Sections of parallel lanes overlap, only compare where the same lane was found
+    const auto section = route->get_map_point_at_s( s );
+    if( frenet->lane_id != section.parent_id )
+      continue;
+    EXPECT_NEAR( frenet->s, s, 1e-3 );
+    EXPECT_NEAR( frenet->d, 0.5, 1e-3 );
+    ++checked;
+  }
+  EXPECT_GT( checked, 0u );
+}
+
+// The polygon hierarchy finds exactly the lanes whose outline contains a point, like testing every lane.
+TEST( MapQueryTest, lanes_containing_matches_brute_force )
+{
+  adore::map::Map map = *load_test_map();
+  map.build_lane_polygons( 0.05, 4 );
+  ASSERT_TRUE( map.lane_polygons );
+  EXPECT_EQ( map.lane_polygons->size(), map.lanes.size() );
+
+  std::vector<adore::map::LanePolygon> all_polygons;
+  for( const auto& [lane_id, lane] : map.lanes )
+    all_polygons.push_back( adore::map::make_lane_polygon( *lane, 0.05 ) );
+
+  // Points on the center lines, halfway to the borders and slightly beyond them
+  std::vector<adore::math::Pose2d> queries;
+  for( double offset : { 0.0, 1.0, 2.5 } )
+  {
+    const auto poses = get_lane_poses( map, offset );
+    queries.insert( queries.end(), poses.begin(), poses.end() );
+  }
+
+  for( const auto& query : queries )
+  {
+    std::vector<adore::map::LaneID> expected;
+    for( const auto& polygon : all_polygons )
+    {
+      if( polygon.contains( query.x, query.y ) )
+        expected.push_back( polygon.lane_id );
+    }
+    std::sort( expected.begin(), expected.end() );
+    EXPECT_EQ( map.lanes_containing( query ), expected );
+  }
+
+  // Lanes contain the middle of their own center line, except a few junction lanes whose borders cross
+  size_t self_contained = 0;
+  for( const auto& [lane_id, lane] : map.lanes )
+  {
+    const auto& points = lane->borders.center.interpolated_points;
+    const auto  found  = map.lanes_containing( points[points.size() / 2] );
+    if( std::binary_search( found.begin(), found.end(), lane_id ) )
+      ++self_contained;
+    ASSERT_NE( map.lane_polygons->find( lane_id ), nullptr );
+  }
+  EXPECT_GT( self_contained, map.lanes.size() * 95 / 100 );
+
+  // Changing the lanes drops the index, queries fall back to outlining nearby lanes
+  const auto  removed_id = map.lanes.begin()->first;
+  const auto& points     = map.lanes.begin()->second->borders.center.interpolated_points;
+  const auto  middle     = points[points.size() / 2];
+  map.remove_lane( removed_id );
+  EXPECT_FALSE( map.lane_polygons );
+  const auto found = map.lanes_containing( middle );
+  EXPECT_FALSE( std::binary_search( found.begin(), found.end(), removed_id ) );
+}
+
+// Raster cells agree with the exact lane outlines at their centers and follow lane removal.
+TEST( MapQueryTest, raster_lookup_matches_lane_outlines )
+{
+  adore::map::Map map = *load_test_map();
+
+  adore::map::RasterConfig config;
+  config.resolution = 0.25;
+  config.tile_size  = 40.0;
+  map.build_raster( config, 4 );
+  ASSERT_TRUE( map.raster );
+  EXPECT_GT( map.raster->size(), 0u );
+
+  // Query at cell centers, where the raster is exact
+  auto cell_center = [&]( double value ) { return ( std::floor( value / config.resolution ) + 0.5 ) * config.resolution; };
+
+  size_t checked = 0;
+  for( const auto& pose : get_lane_poses( map, 0.7 ) )
+  {
+    const double x = cell_center( pose.x );
+    const double y = cell_center( pose.y );
+
+    std::vector<adore::map::LaneID> containing;
+    for( const auto& [lane_id, lane] : map.lanes )
+    {
+      if( adore::map::make_lane_polygon( *lane, config.polygon_tolerance ).contains( x, y ) )
+        containing.push_back( lane_id );
+    }
+
+    const auto lane_id = map.raster->lane_at( x, y );
+    ASSERT_EQ( lane_id.has_value(), !containing.empty() );
+    if( !lane_id )
+      continue;
+
+    EXPECT_TRUE( std::find( containing.begin(), containing.end(), *lane_id ) != containing.end() );
+    EXPECT_EQ( map.raster->lane_type_at( x, y ), map.lanes.at( *lane_id )->type );
+    EXPECT_EQ( map.raster->is_drivable( x, y ), map.lanes.at( *lane_id )->type == adore::map::driving
+                                                  || map.lanes.at( *lane_id )->type == adore::map::parking
+                                                  || map.lanes.at( *lane_id )->type == adore::map::bus );
+    ++checked;
+  }
+  EXPECT_GT( checked, 0u );
+  EXPECT_FALSE( map.raster->lane_at( 0.0, 0.0 ).has_value() );
+  EXPECT_FALSE( map.raster->is_drivable( 0.0, 0.0 ) );
+
+  // Removing a lane only re-renders the tiles it covered and clears its cells
+  const auto  before     = map.raster;
+  const auto  removed_id = map.lanes.begin()->first;
+  const auto& points     = map.lanes.begin()->second->borders.center.interpolated_points;
+  const auto  middle     = points[points.size() / 2];
+  const auto  far_key    = before->get_key( middle.x + 1000.0, middle.y + 1000.0 );
+  map.remove_lane( removed_id );
+
+  ASSERT_NE( map.raster, before );
+  EXPECT_NE( map.raster->lane_at( middle.x, middle.y ), std::optional<adore::map::LaneID>( removed_id ) );
+  EXPECT_EQ( before->lane_at( cell_center( middle.x ), cell_center( middle.y ) ), std::optional<adore::map::LaneID>( removed_id ) );
+  EXPECT_EQ( map.raster->get_tile( far_key ), before->get_tile( far_key ) );
+
+  size_t shared_tiles = 0;
+  for( const auto& [lane_id, lane] : map.lanes )
+  {
+    const auto& point = lane->borders.center.interpolated_points.front();
+    const auto  key   = before->get_key( point.x, point.y );
+    if( map.raster->get_tile( key ) == before->get_tile( key ) )
+      ++shared_tiles;
+  }
+  EXPECT_GT( shared_tiles, 0u );
+}
+
+// Distance field samples agree with a brute force search over the raster cells, also when tiles are
+// computed concurrently.
+TEST( MapQueryTest, distance_field_matches_brute_force )
+{
+  adore::map::Map map = *load_test_map();
+
+  adore::map::RasterConfig config;
+  config.resolution = 0.25;
+  config.tile_size  = 40.0;
+  map.build_raster( config, 4 );
+  ASSERT_TRUE( map.raster );
+
+  const double                   max_distance = 3.0;
+  const adore::map::DistanceField field( map.raster, max_distance );
+  EXPECT_EQ( field.cached_tiles(), 0u );
+
+  // Signed distance between cell centers of the other class, as the field defines it
+  const double resolution  = config.resolution;
+  auto         cell_center = [&]( double value ) { return ( std::floor( value / resolution ) + 0.5 ) * resolution; };
+  auto         brute_force = [&]( double x, double y ) {
+    const bool   inside = map.raster->is_drivable( x, y );
+    const int    reach  = static_cast<int>( std::ceil( max_distance / resolution ) ) + 1;
+    double       best   = std::numeric_limits<double>::max();
+    for( int i = -reach; i <= reach; ++i )
+    {
+      for( int j = -reach; j <= reach; ++j )
+      {
+        if( map.raster->is_drivable( x + i * resolution, y + j * resolution ) != inside )
+          best = std::min( best, std::hypot( i, j ) * resolution );
+      }
+    }
+    const double distance = inside ? best - 0.5 * resolution : 0.5 * resolution - best;
+    return std::clamp( distance, -max_distance, max_distance );
+  };
+
+  size_t checked = 0;
+  size_t inside  = 0;
+  for( const auto& pose : get_lane_poses( map, 3.1 ) )
+  {
+    for( const double offset : { 0.0, 1.3, -2.9 } )
+    {
+      const double x = cell_center( pose.x - std::sin( pose.yaw ) * offset );
+      const double y = cell_center( pose.y + std::cos( pose.yaw ) * offset );
+
+      const double distance = field.get_distance( x, y );
+      EXPECT_NEAR( distance, brute_force( x, y ), 1e-4 );
+      EXPECT_EQ( distance > 0.0, map.raster->is_drivable( x, y ) );
+      EXPECT_LE( std::abs( distance ), max_distance );
+      inside += distance > 0.0;
+      ++checked;
+    }
+  }
+  EXPECT_GT( checked, 0u );
+  EXPECT_GT( inside, 0u );
+  EXPECT_GT( field.cached_tiles(), 0u );
+  EXPECT_NEAR( field.get_distance( -1e5, -1e5 ), -max_distance, 1e-9 );
+
+  // The gradient is the derivative of the bilinear interpolation within a cell
+  size_t gradients = 0;
+  for( const auto& pose : get_lane_poses( map, 9.7 ) )
+  {
+    const double x      = cell_center( pose.x ) + 0.3 * resolution;
+    const double y      = cell_center( pose.y ) + 0.4 * resolution;
+    const double h      = 0.05 * resolution;
+    const auto   sample = field.sample( x, y );
+    EXPECT_NEAR( sample.dx, ( field.get_distance( x + h, y ) - field.get_distance( x - h, y ) ) / ( 2 * h ), 1e-3 );
+    EXPECT_NEAR( sample.dy, ( field.get_distance( x, y + h ) - field.get_distance( x, y - h ) ) / ( 2 * h ), 1e-3 );
+    ++gradients;
+  }
+  EXPECT_GT( gradients, 0u );
+
+  // Lazy tiles computed by racing threads give the same distances
+  const adore::map::DistanceField concurrent( map.raster, max_distance );
+  const auto                      poses = get_lane_poses( map, 1.9 );
+  std::vector<double>             distances( poses.size() );
+  adore::map::parallel_for( poses.size(), 8, [&]( size_t i ) { distances[i] = concurrent.get_distance( poses[i].x, poses[i].y ); } );
+  for( size_t i = 0; i < poses.size(); ++i )
+    EXPECT_EQ( distances[i], field.get_distance( poses[i].x, poses[i].y ) );
+}
+
+// Nearest boundary and crossing queries agree with a linear scan over all border segments, and leaving a
+// lane sideways crosses one of its own borders.
+TEST( MapQueryTest, boundary_queries_match_linear_scan )
+{
+  adore::map::Map map = *load_test_map();
+  map.build_lane_polygons( 0.05, 4 );
+  map.build_boundaries( adore::map::BoundaryConfig(), 4 );
+  ASSERT_TRUE( map.boundaries );
+  ASSERT_GT( map.boundaries->size(), 0u );
+
+  const auto& segments = map.boundaries->get_segments();
+  const auto  edges    = std::count_if( segments.begin(), segments.end(),
+                                        []( const adore::map::BoundarySegment& segment ) { return segment.type == adore::map::road_edge; } );
+  EXPECT_GT( edges, 0 );
+  EXPECT_LT( static_cast<size_t>( edges ), segments.size() );
+
+  auto scan_distance = [&]( double x, double y, std::optional<adore::map::BoundaryType> type ) {
+    double best = std::numeric_limits<double>::max();
+    for( const auto& segment : segments )
+    {
+      if( type && segment.type != *type )
+        continue;
+      const double dx = segment.end.x - segment.start.x;
+      const double dy = segment.end.y - segment.start.y;
+      const double t  = std::clamp( ( ( x - segment.start.x ) * dx + ( y - segment.start.y ) * dy ) / ( dx * dx + dy * dy ), 0.0, 1.0 );
+      best            = std::min( best, std::hypot( segment.start.x + t * dx - x, segment.start.y + t * dy - y ) );
+    }
+    return best;
+  };
+
+  std::vector<adore::map::LaneID> lane_ids;
+  const auto                      poses   = get_lane_poses( map, 0.0, &lane_ids );
+  size_t                          crossed = 0;
+  for( size_t i = 0; i < poses.size(); ++i )
+  {
+    const auto& pose = poses[i];
+    for( const auto type : { std::optional<adore::map::BoundaryType>(), std::optional( adore::map::road_edge ) } )
+    {
+      const auto hit = map.boundaries->nearest( pose.x, pose.y, std::numeric_limits<double>::max(), type );
+      ASSERT_TRUE( hit );
+      EXPECT_NEAR( hit->distance, scan_distance( pose.x, pose.y, type ), 1e-9 );
+      EXPECT_NEAR( hit->distance, std::hypot( hit->x - pose.x, hit->y - pose.y ), 1e-9 );
+      if( type )
+      {
+        EXPECT_EQ( hit->type, *type );
+      }
+    }
+    EXPECT_FALSE( map.boundaries->nearest( pose.x, pose.y, 1e-6 ) );
+
+    // Leave the lane to the left, well past its width
+    const double width = map.lanes.at( lane_ids[i] )->get_width( map.lanes.at( lane_ids[i] )->length / 2 );
+    const double end_x = pose.x - std::sin( pose.yaw ) * ( width + 1.0 );
+    const double end_y = pose.y + std::cos( pose.yaw ) * ( width + 1.0 );
+    const auto   hits  = map.boundaries->crossings( pose.x, pose.y, end_x, end_y );
+
+    auto   cross    = []( double ax, double ay, double bx, double by ) { return ax * by - ay * bx; };
+    size_t expected = 0;
+    for( const auto& segment : segments )
+    {
+      const double ex    = segment.end.x - segment.start.x;
+      const double ey    = segment.end.y - segment.start.y;
+      const double denom = cross( end_x - pose.x, end_y - pose.y, ex, ey );
+      if( denom == 0.0 )
+        continue;
+      const double u = cross( segment.start.x - pose.x, segment.start.y - pose.y, ex, ey ) / denom;
+      const double t = cross( segment.start.x - pose.x, segment.start.y - pose.y, end_x - pose.x, end_y - pose.y ) / denom;
+      expected += u >= 0.0 && u <= 1.0 && t >= 0.0 && t < 1.0;
+    }
+    EXPECT_EQ( hits.size(), expected );
+    EXPECT_TRUE( std::is_sorted( hits.begin(), hits.end(), []( const auto& a, const auto& b ) { return a.distance < b.distance; } ) );
+    crossed += std::any_of( hits.begin(), hits.end(), [&]( const adore::map::BoundaryHit& hit ) { return hit.lane_id == lane_ids[i]; } );
+  }
+  EXPECT_GT( crossed, poses.size() * 95 / 100 );
+
+  map.remove_lane( map.lanes.begin()->first );
+  EXPECT_FALSE( map.boundaries );
+}
@@ -0,0 +1,1210 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "adore_map/compact_road_graph.hpp"
+#include "adore_map/contraction_hierarchy.hpp"
+#include "adore_map/landmarks.hpp"
+#include "adore_map/lane_store.hpp"
+#include "adore_map/map.hpp"
+#include "adore_map/map_loader.hpp"
+#include "adore_map/road_graph.hpp"
+#include "adore_map/route_cache.hpp"
+#include "adore_map/weight_overlay.hpp"
+
+#ifndef ADORE_MAP_TEST_DATA_DIR
+  // Fallback – will be overridden from CMake for real tests.
+  #define ADORE_MAP_TEST_DATA_DIR "."
+#endif
+
+namespace
+{
+const adore::map::Map&
+load_test_map()
+{
+  static const adore::map::Map map = adore::map::MapLoader::load_from_file( std::string( ADORE_MAP_TEST_DATA_DIR ) + "/test_map.r2sr",
+                                                                            true );
+  return map;
+}
+
+// Grid of lanes 10 to 15 m long, each connected to its neighbours in all four directions, with lane changes
+// to the left neighbour on every other row
+adore::map::RoadGraph
+make_grid_graph( size_t rows, size_t columns, unsigned seed )
+{
+  std::mt19937                           rng( seed );
+  std::uniform_real_distribution<double> length( 10.0, 15.0 );
+
+  adore::map::RoadGraph graph;
+  auto                  add = [&]( size_t from, size_t to, adore::map::ConnectionType type ) {
+    adore::map::Connection connection;
+    connection.from_id         = from;
+    connection.to_id           = to;
+    connection.weight          = length( rng );
+    connection.connection_type = type;
+    graph.add_connection( connection );
+  };
+
+  for( size_t row = 0; row < rows; ++row )
+  {
+    for( size_t column = 0; column < columns; ++column )
+    {
+      const size_t lane_id = row * columns + column + 1;
+      if( column + 1 < columns )
+        add( lane_id, lane_id + 1, adore::map::END_TO_START );
+      if( row + 1 < rows )
+        add( lane_id, lane_id + columns, adore::map::END_TO_START );
+      if( row > 0 )
+        add( lane_id, lane_id - columns, adore::map::END_TO_START );
+      if( column > 0 )
+        add( lane_id, lane_id - 1, row % 2 == 0 ? adore::map::PARALLEL : adore::map::END_TO_START );
+    }
+  }
+  return graph;
+}
+
+// Lanes of make_grid_graph, entered at the points of a 10 m grid so no connection is shorter than the
+// distance it bridges
+adore::map::LaneStore
+make_grid_lanes( size_t rows, size_t columns )
+{
+  adore::map::LaneStore lanes;
+  for( size_t row = 0; row < rows; ++row )
+  {
+    for( size_t column = 0; column < columns; ++column )
+    {
+      auto lane = std::make_shared<adore::map::Lane>();
+      lane->id  = row * columns + column + 1;
+      lane->borders.center.interpolated_points.emplace_back( column * 10.0, row * 10.0, lane->id );
+      lane->borders.center.interpolated_points.emplace_back( column * 10.0 + 5.0, row * 10.0, lane->id );
+      lanes.insert( lane );
+    }
+  }
+  return lanes;
+}
+
+// Cost of a path, traversing connections backwards where allowed and cheaper
+double
+path_cost( const adore::map::RoadGraph& graph, const std::deque<adore::map::LaneID>& path, bool allow_reverse )
+{
+  double cost = 0.0;
+  for( size_t i = 1; i < path.size(); ++i )
+  {
+    double step     = std::numeric_limits<double>::infinity();
+    auto   forward  = graph.find_connection( path[i - 1], path[i] );
+    auto   backward = graph.find_connection( path[i], path[i - 1] );
+    if( forward )
+      step = forward->weight;
+    if( allow_reverse && backward )
+      step = std::min( step, backward->weight );
+    cost += step;
+  }
+  return cost;
+}
+} // namespace
+
+// Every connection appears once in the forward and once in the reverse edge arrays, with its weight and type.
+TEST( RoadGraphTest, compact_graph_mirrors_connections )
+{
+  const auto& graph   = load_test_map().lane_graph;
+  const auto  compact = adore::map::CompactRoadGraph::build( graph );
+
+  EXPECT_EQ( compact.edge_count(), graph.all_connections.size() );
+  std::unordered_set<adore::map::LaneID> lane_ids;
+  for( const auto& connection : graph.all_connections )
+  {
+    lane_ids.insert( connection.from_id );
+    lane_ids.insert( connection.to_id );
+  }
+  EXPECT_EQ( compact.node_count(), lane_ids.size() );
+
+  for( const auto& connection : graph.all_connections )
+  {
+    const auto from = compact.find_node( connection.from_id );
+    const auto to   = compact.find_node( connection.to_id );
+    ASSERT_NE( from, adore::map::NO_NODE );
+    ASSERT_NE( to, adore::map::NO_NODE );
+    EXPECT_EQ( compact.get_lane_id( from ), connection.from_id );
+
+    const auto successors = compact.get_successors( from );
+    auto       forward    = std::find_if( successors.begin(), successors.end(), [&]( const auto& edge ) { return edge.target == to; } );
+    ASSERT_NE( forward, successors.end() );
+    EXPECT_EQ( forward->weight, connection.weight );
+    EXPECT_EQ( forward->type, connection.connection_type );
+
+    const auto predecessors = compact.get_predecessors( to );
+    auto reverse = std::find_if( predecessors.begin(), predecessors.end(), [&]( const auto& edge ) { return edge.target == from; } );
+    ASSERT_NE( reverse, predecessors.end() );
+    EXPECT_EQ( reverse->weight, connection.weight );
+    EXPECT_EQ( reverse->type, connection.connection_type );
+  }
+  EXPECT_EQ( compact.find_node( std::numeric_limits<adore::map::LaneID>::max() ), adore::map::NO_NODE );
+}
+
+// Dijkstra on the compact graph finds paths of the same cost as the hash based search, with and without
+// reverse traversal and lane filters.
+TEST( RoadGraphTest, compact_find_path_matches_hash_graph )
+{
+  const auto& graph   = load_test_map().lane_graph;
+  const auto  compact = adore::map::CompactRoadGraph::build( graph );
+
+  std::vector<adore::map::LaneID> lane_ids;
+  for( const auto& [lane_id, lanes] : graph.to_successors )
+    lane_ids.push_back( lane_id );
+  std::sort( lane_ids.begin(), lane_ids.end() );
+  ASSERT_FALSE( lane_ids.empty() );
+
+  // Drop every third lane, the start lane is never filtered
+  auto filter = []( adore::map::LaneID lane_id ) { return lane_id % 3 != 0; };
+
+  size_t found = 0;
+  for( size_t i = 0; i < lane_ids.size(); i += 7 )
+  {
+    for( size_t j = 0; j < lane_ids.size(); j += 5 )
+    {
+      for( const bool allow_reverse : { false, true } )
+      {
+        const auto expected = graph.find_path( lane_ids[i], lane_ids[j], allow_reverse );
+        const auto actual   = compact.find_path( lane_ids[i], lane_ids[j], allow_reverse );
+        ASSERT_EQ( expected.empty(), actual.empty() );
+        if( expected.empty() )
+          continue;
+        EXPECT_EQ( actual.front(), lane_ids[i] );
+        EXPECT_EQ( actual.back(), lane_ids[j] );
+        EXPECT_NEAR( path_cost( graph, actual, allow_reverse ), path_cost( graph, expected, allow_reverse ), 1e-9 );
+        ++found;
+
+        const auto expected_filtered = graph.find_path( lane_ids[i], lane_ids[j], allow_reverse, filter );
+        const auto actual_filtered   = compact.find_path( lane_ids[i], lane_ids[j], allow_reverse, filter );
+        ASSERT_EQ( expected_filtered.empty(), actual_filtered.empty() );
+        if( !actual_filtered.empty() )
+        {
+          EXPECT_TRUE( std::all_of( actual_filtered.begin() + 1, actual_filtered.end(), filter ) );
+          EXPECT_NEAR( path_cost( graph, actual_filtered, allow_reverse ), path_cost( graph, expected_filtered, allow_reverse ), 1e-9 );
+        }
+      }
+    }
+  }
+  EXPECT_GT( found, 0u );
+}
+
+// find_path uses the compact graph once it is built, and changing the graph drops it again.
+TEST( RoadGraphTest, road_graph_uses_and_drops_compact_graph )
+{
+  auto graph = make_grid_graph( 30, 40, 7 );
+  auto plain = graph;
+  graph.build_compact();
+  ASSERT_TRUE( graph.compact );
+  EXPECT_EQ( graph.compact->node_count(), 30u * 40u );
+
+  std::mt19937                          rng( 11 );
+  std::uniform_int_distribution<size_t> lane( 1, 30 * 40 );
+  for( int i = 0; i < 200; ++i )
+  {
+    const size_t from = lane( rng );
+    const size_t to   = lane( rng );
+    for( const bool allow_reverse : { false, true } )
+    {
+      const auto expected = plain.find_path( from, to, allow_reverse );
+      const auto actual   = graph.find_path( from, to, allow_reverse );
+      ASSERT_EQ( expected.empty(), actual.empty() );
+      if( !expected.empty() )
+      {
+        EXPECT_NEAR( path_cost( plain, actual, allow_reverse ), path_cost( plain, expected, allow_reverse ), 1e-9 );
+      }
+    }
+  }
+  EXPECT_EQ( graph.find_path( 5, 5, false ), std::deque<adore::map::LaneID>{ 5 } );
+
+  adore::map::Connection shortcut;
+  shortcut.from_id         = 1;
+  shortcut.to_id           = 30 * 40;
+  shortcut.weight          = 1.0;
+  shortcut.connection_type = adore::map::END_TO_START;
+  graph.add_connection( shortcut );
+  EXPECT_FALSE( graph.compact );
+  EXPECT_EQ( graph.find_path( 1, 30 * 40, false ).size(), 2u );
+
+  graph.build_compact();
+  EXPECT_EQ( graph.find_path( 1, 30 * 40, false ).size(), 2u );
+  graph.remove_lane( 30 * 40 );
+  EXPECT_FALSE( graph.compact );
+}
+
+// Compact graphs rebuilt after an edit, directly or for landmarks and hierarchies, keep the lane positions
+// recorded by the last build with lanes, also in copies that outlive the lanes.
+TEST( RoadGraphTest, rebuilt_compact_graph_keeps_lane_positions )
+{
+  adore::map::RoadGraph graph;
+  {
+    auto lanes = make_grid_lanes( 20, 25 );
+    graph      = make_grid_graph( 20, 25, 13 );
+    graph.build_compact( &lanes );
+  }
+  ASSERT_TRUE( graph.lane_positions );
+  const double scale = graph.compact->get_heuristic_scale();
+  EXPECT_GT( scale, 0.0 );
+
+  const auto weight = graph.find_connection( 1, 2 )->weight;
+  graph.set_weight( 1, 2, 2.0 * weight );
+  EXPECT_FALSE( graph.compact );
+
+  auto copy = graph;
+  copy.build_landmarks( adore::map::LandmarkConfig{ 4, 1 } );
+  ASSERT_TRUE( copy.compact );
+  EXPECT_TRUE( copy.compact->get_landmarks() );
+  EXPECT_GT( copy.compact->get_heuristic_scale(), 0.0 );
+
+  std::mt19937                          rng( 17 );
+  std::uniform_int_distribution<size_t> lane( 1, 20 * 25 );
+  for( int i = 0; i < 100; ++i )
+  {
+    const size_t from     = lane( rng );
+    const size_t to       = lane( rng );
+    const auto   expected = graph.find_path( from, to, false );
+    const auto   actual   = copy.find_path( from, to, false );
+    ASSERT_EQ( expected.empty(), actual.empty() );
+    if( !expected.empty() )
+    {
+      EXPECT_NEAR( path_cost( graph, actual, false ), path_cost( graph, expected, false ), 1e-9 );
+    }
+  }
+
+  // A lane connected later has no recorded position, so A* is off until the lanes are passed again
+  adore::map::Connection connection;
+  connection.from_id = 1;
+  connection.to_id   = 10000;
+  connection.weight  = 1.0;
+  copy.add_connection( connection );
+  copy.build_hierarchy( adore::map::ContractionConfig{} );
+  ASSERT_TRUE( copy.compact );
+  EXPECT_EQ( copy.compact->get_heuristic_scale(), 0.0 );
+}
+
+// A lane inserted again elsewhere under its id moves its recorded position, and A* on the rebuilt compact
+// graph still finds shortest paths.
+TEST( RoadGraphTest, reinserted_lane_moves_lane_position )
+{
+  adore::map::Map map;
+  for( const auto& [lane_id, lane] : make_grid_lanes( 20, 25 ) )
+    map.insert_lane( lane );
+  map.lane_graph = make_grid_graph( 20, 25, 19 );
+  map.lane_graph.build_compact( &map.lanes );
+  const auto reference = make_grid_graph( 20, 25, 19 );
+
+  const adore::map::LaneID moved_id = 7 * 25 + 12;
+  auto                     moved    = std::make_shared<adore::map::Lane>( *map.lanes.at( moved_id ) );
+  for( auto& point : moved->borders.center.interpolated_points )
+  {
+    point.x += 120.0;
+    point.y -= 40.0;
+  }
+  map.insert_lane( moved );
+
+  ASSERT_TRUE( map.lane_graph.compact );
+  ASSERT_TRUE( map.lane_graph.lane_positions );
+  const auto* position = map.lane_graph.lane_positions->find( moved_id );
+  ASSERT_NE( position, nullptr );
+  EXPECT_EQ( position->x, moved->borders.center.interpolated_points.front().x );
+  EXPECT_EQ( position->y, moved->borders.center.interpolated_points.front().y );
+  EXPECT_GT( map.lane_graph.compact->get_heuristic_scale(), 0.0 );
+
+  std::mt19937                          rng( 23 );
+  std::uniform_int_distribution<size_t> lane( 1, 20 * 25 );
+  for( int i = 0; i < 100; ++i )
+  {
+    const size_t from     = i % 2 == 0 ? moved_id : lane( rng );
+    const size_t to       = i % 2 == 0 ? lane( rng ) : moved_id;
+    const auto   expected = reference.find_path( from, to, false );
+    const auto   actual   = map.lane_graph.find_path( from, to, false );
+    ASSERT_EQ( expected.empty(), actual.empty() );
+    if( !expected.empty() )
+    {
+      EXPECT_NEAR( path_cost( reference, actual, false ), path_cost( reference, expected, false ), 1e-9 );
+    }
+  }
+}
+
+// Connections between nearby lane ids spread over distinct hashes in both directions.
+TEST( RoadGraphTest, connection_hash_separates_directions )
+{
+  adore::map::ConnectionHasher hasher;
+  std::unordered_set<size_t>   hashes;
+  size_t                       count = 0;
+  for( size_t from = 0; from < 200; ++from )
+  {
+    for( size_t to = 0; to < 200; ++to )
+    {
+      adore::map::Connection connection;
+      connection.from_id = from;
+      connection.to_id   = to;
+      hashes.insert( hasher( connection ) );
+      ++count;
+    }
+  }
+  EXPECT_EQ( hashes.size(), count );
+}
+
+// A* on lane positions finds paths of optimal cost, and its estimate never exceeds the remaining cost.
+TEST( RoadGraphTest, astar_matches_dijkstra )
+{
+  const size_t rows    = 40;
+  const size_t columns = 50;
+  const auto   graph   = make_grid_graph( rows, columns, 3 );
+  const auto   lanes   = make_grid_lanes( rows, columns );
+  const auto   astar   = adore::map::CompactRoadGraph::build( graph, &lanes );
+  const auto   plain   = adore::map::CompactRoadGraph::build( graph );
+  EXPECT_GE( astar.get_heuristic_scale(), 1.0 - 1e-6 ); // weights are at least the 10 m grid spacing
+  EXPECT_EQ( plain.get_heuristic_scale(), 0.0 );
+
+  std::mt19937                          rng( 5 );
+  std::uniform_int_distribution<size_t> lane( 1, rows * columns );
+  size_t                                found = 0;
+  for( int i = 0; i < 300; ++i )
+  {
+    const size_t from = lane( rng );
+    const size_t to   = lane( rng );
+    for( const bool allow_reverse : { false, true } )
+    {
+      const auto expected = plain.find_path( from, to, allow_reverse );
+      const auto actual   = astar.find_path( from, to, allow_reverse );
+      ASSERT_EQ( expected.empty(), actual.empty() );
+      if( expected.empty() )
+        continue;
+
+      const double cost = path_cost( graph, expected, allow_reverse );
+      EXPECT_NEAR( path_cost( graph, actual, allow_reverse ), cost, 1e-9 );
+      EXPECT_LE( astar.estimate_cost( astar.find_node( from ), astar.find_node( to ) ), cost );
+      ++found;
+    }
+  }
+  EXPECT_GT( found, 0u );
+
+  // A lane missing from the store leaves the graph without a heuristic
+  auto partial = make_grid_lanes( rows, columns );
+  partial.erase( 1 );
+  EXPECT_EQ( adore::map::CompactRoadGraph::build( graph, &partial ).get_heuristic_scale(), 0.0 );
+}
+
+// Loaded maps route with A*, with the same path costs and map distances as the hash graph search.
+TEST( RoadGraphTest, loaded_map_routes_with_astar )
+{
+  const auto& map = load_test_map();
+  ASSERT_TRUE( map.lane_graph.compact );
+  EXPECT_GT( map.lane_graph.compact->get_heuristic_scale(), 0.0 );
+
+  auto plain = map.lane_graph;
+  plain.compact.reset();
+
+  std::vector<adore::map::LaneID> lane_ids;
+  for( const auto& [lane_id, lane] : map.lanes )
+    lane_ids.push_back( lane_id );
+
+  size_t found = 0;
+  for( size_t i = 0; i < lane_ids.size(); i += 3 )
+  {
+    for( size_t j = 0; j < lane_ids.size(); j += 4 )
+    {
+      for( const bool allow_reverse : { false, true } )
+      {
+        const auto expected = plain.find_path( lane_ids[i], lane_ids[j], allow_reverse );
+        const auto actual   = map.lane_graph.find_path( lane_ids[i], lane_ids[j], allow_reverse );
+        ASSERT_EQ( expected.empty(), actual.empty() );
+        if( expected.empty() )
+          continue;
+        EXPECT_NEAR( path_cost( plain, actual, allow_reverse ), path_cost( plain, expected, allow_reverse ), 1e-6 );
+        ++found;
+      }
+    }
+  }
+  EXPECT_GT( found, 0u );
+
+  auto shared = std::make_shared<const adore::map::Map>( map );
+  auto copy   = std::make_shared<adore::map::Map>( map );
+  copy->lane_graph.compact.reset();
+  const std::shared_ptr<const adore::map::Map> unaccelerated = copy;
+  for( size_t i = 0; i + 5 < lane_ids.size(); i += 5 )
+  {
+    const auto& start = shared->lanes.at( lane_ids[i] )->borders.center.interpolated_points.front();
+    const auto& end   = shared->lanes.at( lane_ids[i + 5] )->borders.center.interpolated_points.back();
+    const auto  a     = adore::map::get_map_distance( start, end, shared );
+    const auto  b     = adore::map::get_map_distance( start, end, unaccelerated );
+    EXPECT_EQ( std::isinf( a ), std::isinf( b ) );
+  }
+}
+
+// The bidirectional search finds paths of the same cost as find_path on random pairs, including lane
+// changes, reverse traversal and lane filters.
+TEST( RoadGraphTest, bidirectional_search_matches_find_path )
+{
+  const auto& map       = load_test_map();
+  auto        grid      = make_grid_graph( 30, 40, 13 );
+  const auto  unindexed = grid;
+  grid.build_compact();
+
+  auto filter = []( adore::map::LaneID lane_id ) { return lane_id % 7 != 0; };
+
+  size_t lane_changes = 0;
+  for( const adore::map::RoadGraph* graph : std::vector<const adore::map::RoadGraph*>{ &map.lane_graph, &grid, &unindexed } )
+  {
+    std::vector<adore::map::LaneID> lane_ids;
+    for( const auto& [lane_id, lanes] : graph->to_successors )
+      lane_ids.push_back( lane_id );
+    std::sort( lane_ids.begin(), lane_ids.end() );
+
+    std::mt19937                          rng( 17 );
+    std::uniform_int_distribution<size_t> pick( 0, lane_ids.size() - 1 );
+    size_t                                found = 0;
+    for( int i = 0; i < 300; ++i )
+    {
+      const auto from = lane_ids[pick( rng )];
+      const auto to   = lane_ids[pick( rng )];
+      for( const bool allow_reverse : { false, true } )
+      {
+        for( const bool filtered : { false, true } )
+        {
+          const std::function<bool( adore::map::LaneID )> lane_filter = filtered ? std::function<bool( adore::map::LaneID )>( filter )
+                                                                                 : nullptr;
+
+          const auto expected = graph->find_path( from, to, allow_reverse, lane_filter );
+          const auto actual   = graph->find_path_bidirectional( from, to, allow_reverse, lane_filter );
+          ASSERT_EQ( expected.empty(), actual.empty() ) << from << " -> " << to;
+          if( expected.empty() )
+            continue;
+
+          EXPECT_EQ( actual.front(), from );
+          EXPECT_EQ( actual.back(), to );
+          EXPECT_NEAR( path_cost( *graph, actual, allow_reverse ), path_cost( *graph, expected, allow_reverse ), 1e-9 );
+          if( filtered )
+          {
+            EXPECT_TRUE( std::all_of( actual.begin() + 1, actual.end(), filter ) );
+          }
+          for( size_t k = 1; k < actual.size(); ++k )
+          {
+            const auto connection = graph->find_connection( actual[k - 1], actual[k] );
+            lane_changes += connection && connection->connection_type == adore::map::PARALLEL;
+          }
+          ++found;
+        }
+      }
+    }
+    EXPECT_GT( found, 0u );
+  }
+  EXPECT_GT( lane_changes, 0u );
+  EXPECT_TRUE( map.lane_graph.find_path_bidirectional( 1, 1, false ) == std::deque<adore::map::LaneID>{ 1 } );
+  EXPECT_TRUE( map.lane_graph.find_path_bidirectional( 1, std::numeric_limits<adore::map::LaneID>::max(), true ).empty() );
+}
+
+// Contraction hierarchy queries find paths of the same cost as Dijkstra, also after a rebuild with new
+// weights in the previous order, and RoadGraph::find_path uses the hierarchy for unfiltered searches.
+TEST( RoadGraphTest, contraction_hierarchy_matches_dijkstra )
+{
+  const auto& map  = load_test_map();
+  const auto  grid = make_grid_graph( 20, 25, 21 );
+
+  for( const adore::map::RoadGraph* graph : std::vector<const adore::map::RoadGraph*>{ &map.lane_graph, &grid } )
+  {
+    const auto compact = adore::map::CompactRoadGraph::build( *graph );
+    for( const bool allow_reverse : { false, true } )
+    {
+      adore::map::ContractionConfig config;
+      config.allow_reverse = allow_reverse;
+      const auto hierarchy = adore::map::ContractionHierarchy::build( compact, config );
+      EXPECT_EQ( hierarchy.node_count(), compact.node_count() );
+      EXPECT_EQ( hierarchy.allows_reverse(), allow_reverse );
+      EXPECT_GT( hierarchy.shortcut_count(), 0u );
+
+      config.thread_count = 1;
+      EXPECT_EQ( adore::map::ContractionHierarchy::build( compact, config ).get_order(), hierarchy.get_order() );
+
+      std::mt19937                          rng( 5 );
+      std::uniform_int_distribution<size_t> pick( 0, compact.node_count() - 1 );
+      for( int i = 0; i < 300; ++i )
+      {
+        const auto from     = compact.get_lane_id( pick( rng ) );
+        const auto to       = compact.get_lane_id( pick( rng ) );
+        const auto expected = compact.find_path( from, to, allow_reverse );
+        const auto actual   = hierarchy.find_path( from, to );
+        ASSERT_EQ( expected.empty(), actual.empty() ) << from << " -> " << to;
+        if( expected.empty() )
+          continue;
+
+        EXPECT_EQ( actual.front(), from );
+        EXPECT_EQ( actual.back(), to );
+        EXPECT_NEAR( path_cost( *graph, actual, allow_reverse ), path_cost( *graph, expected, allow_reverse ), 1e-9 );
+      }
+    }
+  }
+
+  // Same lanes and connections with other weights, contracted in the order of the first hierarchy
+  auto       reweighted = make_grid_graph( 20, 25, 22 );
+  const auto previous   = adore::map::ContractionHierarchy::build( adore::map::CompactRoadGraph::build( grid ) );
+  reweighted.build_hierarchy( adore::map::ContractionConfig{}, &previous );
+  ASSERT_TRUE( reweighted.hierarchy );
+  EXPECT_EQ( reweighted.hierarchy->get_order(), previous.get_order() );
+
+  std::mt19937                          rng( 9 );
+  std::uniform_int_distribution<size_t> lane( 1, 20 * 25 );
+  for( int i = 0; i < 300; ++i )
+  {
+    const size_t from     = lane( rng );
+    const size_t to       = lane( rng );
+    const auto   expected = reweighted.compact->find_path( from, to, false );
+    const auto   actual   = reweighted.find_path( from, to, false );
+    ASSERT_FALSE( actual.empty() );
+    EXPECT_NEAR( path_cost( reweighted, actual, false ), path_cost( reweighted, expected, false ), 1e-9 );
+  }
+
+  reweighted.remove_lane( 1 );
+  EXPECT_FALSE( reweighted.hierarchy );
+}
+
+// A hierarchy read back from its file answers queries like the original, corrupt and inconsistent files are
+// rejected.
+TEST( RoadGraphTest, contraction_hierarchy_round_trips_through_file )
+{
+  const auto&                   map = load_test_map();
+  adore::map::ContractionConfig config;
+  config.allow_reverse = true;
+  const auto hierarchy = adore::map::ContractionHierarchy::build( *map.lane_graph.compact, config );
+
+  const std::string file = ::testing::TempDir() + "road_graph_test.ch";
+  hierarchy.write( file );
+  const auto loaded = adore::map::ContractionHierarchy::read( file );
+  EXPECT_TRUE( loaded.allows_reverse() );
+  EXPECT_EQ( loaded.node_count(), hierarchy.node_count() );
+  EXPECT_EQ( loaded.edge_count(), hierarchy.edge_count() );
+  EXPECT_EQ( loaded.get_order(), hierarchy.get_order() );
+
+  const auto& compact = *map.lane_graph.compact;
+  for( const auto& [first, second] : std::vector<std::pair<size_t, size_t>>{ { 0, compact.node_count() - 1 }, { compact.node_count() / 2, 3 } } )
+  {
+    const auto from = compact.get_lane_id( first );
+    const auto to   = compact.get_lane_id( second );
+    EXPECT_EQ( loaded.find_path( from, to ), hierarchy.find_path( from, to ) );
+  }
+
+  // Ranks that are no permutation or do not order the edges, and a shortcut bypassing a more important node
+  std::vector<char> bytes( std::filesystem::file_size( file ) );
+  std::ifstream( file, std::ios::binary ).read( bytes.data(), static_cast<std::streamsize>( bytes.size() ) );
+  const size_t node_count    = hierarchy.node_count();
+  const size_t ranks_at      = 48 + node_count * sizeof( adore::map::LaneID );
+  const size_t up_offsets_at = ranks_at + node_count * sizeof( uint32_t );
+  const size_t up_edges_at   = up_offsets_at + ( node_count + 1 ) * sizeof( uint32_t );
+  auto         expect_reject = [&]( const std::vector<char>& corrupt ) {
+    std::ofstream( file, std::ios::binary | std::ios::trunc ).write( corrupt.data(), static_cast<std::streamsize>( corrupt.size() ) );
+    EXPECT_THROW( adore::map::ContractionHierarchy::read( file ), std::runtime_error );
+  };
+
+  auto duplicate_rank = bytes;
+  std::memcpy( duplicate_rank.data() + ranks_at + sizeof( uint32_t ), duplicate_rank.data() + ranks_at, sizeof( uint32_t ) );
+  expect_reject( duplicate_rank );
+
+  auto reversed_ranks = bytes;
+  for( size_t node = 0; node < node_count; ++node )
+  {
+    uint32_t rank;
+    std::memcpy( &rank, reversed_ranks.data() + ranks_at + node * sizeof( rank ), sizeof( rank ) );
+    rank = static_cast<uint32_t>( node_count - 1 - rank );
+    std::memcpy( reversed_ranks.data() + ranks_at + node * sizeof( rank ), &rank, sizeof( rank ) );
+  }
+  expect_reject( reversed_ranks );
+
+  auto   bad_shortcut = bytes;
+  size_t shortcuts    = 0;
+  for( size_t at = up_edges_at; at + sizeof( adore::map::HierarchyEdge ) <= bytes.size() && shortcuts == 0;
+       at += sizeof( adore::map::HierarchyEdge ) )
+  {
+    adore::map::HierarchyEdge edge;
+    std::memcpy( &edge, bad_shortcut.data() + at, sizeof( edge ) );
+    if( edge.middle == adore::map::NO_NODE )
+      continue;
+    edge.middle = edge.target;
+    std::memcpy( bad_shortcut.data() + at, &edge, sizeof( edge ) );
+    ++shortcuts;
+  }
+  ASSERT_EQ( shortcuts, 1u );
+  expect_reject( bad_shortcut );
+
+  // Truncated file
+  std::ofstream( file, std::ios::binary | std::ios::trunc ).write( bytes.data(), static_cast<std::streamsize>( bytes.size() ) );
+  EXPECT_NO_THROW( adore::map::ContractionHierarchy::read( file ) );
+  std::filesystem::resize_file( file, std::filesystem::file_size( file ) - 8 );
+  EXPECT_THROW( adore::map::ContractionHierarchy::read( file ), std::runtime_error );
+  std::remove( file.c_str() );
+  EXPECT_THROW( adore::map::ContractionHierarchy::read( file ), std::runtime_error );
+}
+
+// Landmark estimates never exceed the remaining cost, searches using them find paths as cheap as Dijkstra,
+// and the landmarks stay usable after connections get more expensive or disappear.
+TEST( RoadGraphTest, landmarks_bound_costs_and_survive_closures )
+{
+  auto                       grid      = make_grid_graph( 30, 40, 31 );
+  auto                       map_graph = load_test_map().lane_graph;
+  adore::map::LandmarkConfig config;
+  config.landmark_count = 8;
+
+  std::mt19937 rng( 3 );
+  auto         compare = [&]( const adore::map::RoadGraph& graph ) {
+    ASSERT_TRUE( graph.compact );
+    ASSERT_TRUE( graph.compact->get_landmarks() );
+    const auto dijkstra = adore::map::CompactRoadGraph::build( graph );
+    const auto filter   = []( adore::map::LaneID lane_id ) { return lane_id % 5 != 0; };
+
+    std::uniform_int_distribution<size_t> pick( 0, dijkstra.node_count() - 1 );
+    for( int i = 0; i < 200; ++i )
+    {
+      const auto from = dijkstra.get_lane_id( pick( rng ) );
+      const auto to   = dijkstra.get_lane_id( pick( rng ) );
+      for( const bool allow_reverse : { false, true } )
+      {
+        for( const bool filtered : { false, true } )
+        {
+          const std::function<bool( adore::map::LaneID )> lane_filter = filtered ? std::function<bool( adore::map::LaneID )>( filter )
+                                                                                 : nullptr;
+
+          const auto expected = dijkstra.find_path( from, to, allow_reverse, lane_filter );
+          const auto actual   = graph.compact->find_path( from, to, allow_reverse, lane_filter );
+          ASSERT_EQ( expected.empty(), actual.empty() ) << from << " -> " << to;
+          if( expected.empty() )
+            continue;
+
+          const double cost = path_cost( graph, expected, allow_reverse );
+          EXPECT_NEAR( path_cost( graph, actual, allow_reverse ), cost, 1e-9 );
+          EXPECT_LE( graph.compact->estimate_cost( graph.compact->find_node( from ), graph.compact->find_node( to ), allow_reverse ), cost );
+        }
+      }
+    }
+  };
+
+  for( auto* graph : { &grid, &map_graph } )
+  {
+    graph->build_landmarks( config );
+    ASSERT_TRUE( graph->landmarks );
+    EXPECT_EQ( graph->landmarks->landmark_count(), 8u );
+    compare( *graph );
+  }
+  EXPECT_GT( map_graph.compact->get_heuristic_scale(), 0.0 ); // lane positions are kept
+
+  // Closures and slower connections keep the landmarks
+  const auto landmarks = grid.landmarks;
+  std::vector<adore::map::Connection> connections( grid.all_connections.begin(), grid.all_connections.end() );
+  std::sort( connections.begin(), connections.end(), []( const auto& a, const auto& b ) {
+    return std::tie( a.from_id, a.to_id ) < std::tie( b.from_id, b.to_id );
+  } );
+  std::shuffle( connections.begin(), connections.end(), rng );
+  for( size_t i = 0; i < 300; ++i )
+    EXPECT_TRUE( grid.set_weight( connections[i].from_id, connections[i].to_id, connections[i].weight * 5.0 ) );
+  for( const adore::map::LaneID lane_id : { 17, 230, 231, 232, 600 } )
+    grid.remove_lane( lane_id );
+  EXPECT_FALSE( grid.compact );
+  EXPECT_EQ( grid.landmarks, landmarks );
+  grid.build_compact();
+  compare( grid );
+
+  // A cheaper connection invalidates them
+  EXPECT_FALSE( grid.set_weight( 1, 40 * 30, 1.0 ) );
+  EXPECT_TRUE( grid.set_weight( connections[400].from_id, connections[400].to_id, connections[400].weight * 0.5 ) );
+  EXPECT_FALSE( grid.landmarks );
+}
+
+// Reachable sets hold exactly the lanes whose find_path cost is within the budget, in every direction and
+// with lane changes left out, and their predecessor trees give paths of that cost. The map searches the
+// compact graph, the grid the hash maps.
+TEST( RoadGraphTest, reachable_lanes_match_find_path )
+{
+  const auto& map  = load_test_map();
+  const auto  grid = make_grid_graph( 20, 25, 29 );
+
+  for( const auto& [source, max_cost] : std::vector<std::pair<const adore::map::RoadGraph*, double>>{ { &map.lane_graph, 150.0 },
+                                                                                                       { &grid, 60.0 } } )
+  {
+    // Same graph without lane changes
+    adore::map::RoadGraph no_lane_changes;
+    for( const auto& connection : source->all_connections )
+    {
+      if( connection.connection_type != adore::map::PARALLEL )
+        no_lane_changes.add_connection( connection );
+    }
+
+    std::vector<adore::map::LaneID> lane_ids;
+    for( const auto& [lane_id, lanes] : source->to_successors )
+      lane_ids.push_back( lane_id );
+    std::sort( lane_ids.begin(), lane_ids.end() );
+
+    std::mt19937                          rng( 5 );
+    std::uniform_int_distribution<size_t> pick( 0, lane_ids.size() - 1 );
+    size_t                                reached = 0;
+    for( int i = 0; i < 4; ++i )
+    {
+      const auto from = lane_ids[pick( rng )];
+      for( const bool allow_lane_changes : { true, false } )
+      {
+        const auto& graph = allow_lane_changes ? *source : no_lane_changes;
+        for( const auto direction : { adore::map::FORWARD, adore::map::BACKWARD, adore::map::BOTH } )
+        {
+          const bool allow_reverse = direction == adore::map::BOTH;
+          const auto reachable     = source->find_reachable( from, max_cost, direction, allow_lane_changes );
+          ASSERT_FALSE( reachable.lanes.empty() );
+          reached += reachable.lanes.size() - 1;
+          EXPECT_EQ( reachable.lanes.front().lane_id, from );
+          EXPECT_EQ( reachable.lanes.front().previous, from );
+          for( size_t k = 1; k < reachable.lanes.size(); ++k )
+            EXPECT_LE( reachable.lanes[k - 1].cost, reachable.lanes[k].cost );
+
+          for( const auto lane_id : lane_ids )
+          {
+            const auto expected = direction == adore::map::BACKWARD ? graph.find_path( lane_id, from, false )
+                                                                    : graph.find_path( from, lane_id, allow_reverse );
+            const auto* lane    = reachable.find( lane_id );
+            if( expected.empty() || path_cost( graph, expected, allow_reverse ) > max_cost + 1e-9 )
+            {
+              EXPECT_EQ( lane, nullptr ) << from << " " << lane_id << " " << direction;
+              continue;
+            }
+            ASSERT_NE( lane, nullptr ) << from << " " << lane_id << " " << direction;
+            EXPECT_NEAR( lane->cost, path_cost( graph, expected, allow_reverse ), 1e-9 );
+
+            const auto path = reachable.get_path( lane_id );
+            EXPECT_EQ( direction == adore::map::BACKWARD ? path.back() : path.front(), from );
+            EXPECT_EQ( direction == adore::map::BACKWARD ? path.front() : path.back(), lane_id );
+            EXPECT_NEAR( path_cost( graph, path, allow_reverse ), lane->cost, 1e-9 );
+          }
+        }
+      }
+    }
+    EXPECT_GT( reached, 100u );
+  }
+
+  EXPECT_TRUE( grid.find_reachable( 1, -1.0 ).lanes.empty() );
+  const auto lone = grid.find_reachable( 100000, 10.0 );
+  ASSERT_EQ( lone.lanes.size(), 1u );
+  EXPECT_EQ( lone.get_path( 100000 ), std::deque<adore::map::LaneID>{ 100000 } );
+}
+
+// The distance matrix agrees with get_map_distance for every pair of points inside lanes, including pairs on
+// the same lane and repeated start lanes, with and without the compact graph
+TEST( RoadGraphTest, distance_matrix_matches_map_distance )
+{
+  const auto& map    = load_test_map();
+  auto        shared = std::make_shared<const adore::map::Map>( map );
+  auto        copy   = std::make_shared<adore::map::Map>( map );
+  copy->lane_graph.compact.reset();
+  const std::shared_ptr<const adore::map::Map> unaccelerated = copy;
+
+  std::vector<adore::map::LaneID> lane_ids;
+  for( const auto& [lane_id, lane] : map.lanes )
+  {
+    if( !lane->borders.center.interpolated_points.empty() )
+      lane_ids.push_back( lane_id );
+  }
+  std::sort( lane_ids.begin(), lane_ids.end() );
+
+  std::mt19937                          rng( 11 );
+  std::uniform_int_distribution<size_t> pick( 0, lane_ids.size() - 1 );
+  auto                                  random_point = [&]() {
+    const auto& points = map.lanes.at( lane_ids[pick( rng )] )->borders.center.interpolated_points;
+    return points[std::uniform_int_distribution<size_t>( 0, points.size() - 1 )( rng )];
+  };
+  std::vector<adore::map::MapPoint> starts, ends;
+  for( int i = 0; i < 25; ++i )
+  {
+    starts.push_back( random_point() );
+    ends.push_back( random_point() );
+  }
+  starts.push_back( ends.front() );
+  ends.push_back( starts.front() );
+
+  const auto distances = adore::map::get_map_distances( starts, ends, shared );
+  ASSERT_EQ( distances.size(), starts.size() );
+  size_t found = 0;
+  for( size_t row = 0; row < starts.size(); ++row )
+  {
+    ASSERT_EQ( distances[row].size(), ends.size() );
+    for( size_t column = 0; column < ends.size(); ++column )
+    {
+      const double expected = adore::map::get_map_distance( starts[row], ends[column], shared );
+      if( std::isinf( expected ) )
+      {
+        EXPECT_TRUE( std::isinf( distances[row][column] ) );
+        continue;
+      }
+      EXPECT_NEAR( distances[row][column], expected, 1e-6 ) << starts[row].parent_id << " -> " << ends[column].parent_id;
+      ++found;
+    }
+  }
+  EXPECT_GT( found, 0u );
+  EXPECT_EQ( adore::map::get_map_distances( starts, ends, unaccelerated, 1 ), distances );
+  EXPECT_TRUE( adore::map::get_map_distances( {}, ends, shared ).empty() );
+}
+
+// Cached routes are returned until the graph changes, copies of an unchanged graph share them, and the cache
+// never holds more routes than its capacity
+TEST( RoadGraphTest, route_cache_follows_graph_version )
+{
+  auto                   grid = make_grid_graph( 10, 10, 3 );
+  adore::map::RouteCache cache( 3 );
+
+  const auto route = grid.find_path( 1, 100, false );
+  EXPECT_EQ( cache.get_best_path( grid, 1, 100 ), route );
+  EXPECT_EQ( cache.find_path( grid, 1, 100, false ), route );
+  EXPECT_EQ( cache.find_path( grid, 1, 100, true ), grid.find_path( 1, 100, true ) );
+  auto stats = cache.get_stats();
+  EXPECT_EQ( stats.hits, 1u );
+  EXPECT_EQ( stats.misses, 2u );
+  EXPECT_EQ( stats.size, 2u );
+
+  // A copy has the same version and hits, building accelerators does not change it
+  auto copy = grid;
+  copy.build_compact();
+  EXPECT_EQ( copy.version, grid.version );
+  EXPECT_EQ( cache.find_path( copy, 1, 100, false ), route );
+  EXPECT_EQ( cache.get_stats().hits, 2u );
+
+  // Closing the first connection of the route changes it
+  const uint64_t version = grid.version;
+  ASSERT_TRUE( grid.set_weight( route[0], route[1], 1e6 ) );
+  EXPECT_NE( grid.version, version );
+  const auto rerouted = cache.find_path( grid, 1, 100, false );
+  EXPECT_EQ( rerouted, grid.find_path( 1, 100, false ) );
+  EXPECT_NE( rerouted, route );
+  EXPECT_EQ( cache.get_stats().misses, 3u );
+
+  // The copy did not change and keeps its route, a new connection gives it a version of its own
+  EXPECT_EQ( cache.find_path( copy, 1, 100, false ), route );
+  adore::map::Connection shortcut;
+  shortcut.from_id = 1;
+  shortcut.to_id   = 100;
+  shortcut.weight  = 1.0;
+  copy.add_connection( shortcut );
+  EXPECT_NE( copy.version, grid.version );
+  EXPECT_EQ( cache.find_path( copy, 1, 100, false ), ( std::deque<adore::map::LaneID>{ 1, 100 } ) );
+
+  stats = cache.get_stats();
+  EXPECT_EQ( stats.hits, 3u );
+  EXPECT_EQ( stats.misses, 4u );
+  EXPECT_EQ( stats.size, 3u );
+  EXPECT_NEAR( stats.hit_rate(), 3.0 / 7.0, 1e-12 );
+
+  cache.clear();
+  EXPECT_EQ( cache.get_stats().size, 0u );
+  EXPECT_EQ( cache.get_stats().hits + cache.get_stats().misses, 0u );
+}
+
+// Routes on an overlay cost the same as on a graph with the overlay weights set, with A* on positions and
+// landmarks while weights only grow and without once one got cheaper. Published overlays do not change.
+TEST( RoadGraphTest, weight_overlay_matches_reweighted_graph )
+{
+  auto       grid  = make_grid_graph( 20, 25, 21 );
+  auto       lanes = make_grid_lanes( 20, 25 );
+  const auto base  = grid;
+  grid.build_compact( &lanes );
+  grid.build_landmarks( adore::map::LandmarkConfig{ 4, 1 } );
+  ASSERT_TRUE( grid.compact->get_landmarks() );
+
+  auto reference = base;
+  auto overlay   = std::make_shared<adore::map::WeightOverlay>( grid.compact );
+
+  // Closures are modelled as very expensive connections in the reference. A closed lane cannot be entered
+  // from either end, the reference also closes its way out, so routes starting on it are not compared.
+  const double closed = 1e9;
+  std::mt19937 rng( 2 );
+  std::uniform_int_distribution<adore::map::LaneID> lane( 1, 20 * 25 );
+  std::unordered_set<adore::map::LaneID>            closed_lanes;
+  for( int i = 0; i < 15; ++i )
+  {
+    const auto lane_id = lane( rng );
+    EXPECT_TRUE( overlay->close_lane( lane_id ) );
+    closed_lanes.insert( lane_id );
+    for( const auto predecessor : base.to_predecessors.at( lane_id ) )
+      reference.set_weight( predecessor, lane_id, closed );
+    for( const auto successor : base.to_successors.at( lane_id ) )
+      reference.set_weight( lane_id, successor, closed );
+  }
+  EXPECT_THROW( overlay->scale_lane( 1, -1.0 ), std::invalid_argument );
+  EXPECT_THROW( overlay->scale_lane( 1, std::numeric_limits<double>::quiet_NaN() ), std::invalid_argument );
+  EXPECT_THROW( overlay->scale_lane( 1, std::numeric_limits<double>::infinity() ), std::invalid_argument );
+  for( int i = 0; i < 15; ++i )
+  {
+    const auto lane_id = lane( rng );
+    EXPECT_TRUE( overlay->scale_lane( lane_id, 3.0 ) );
+    for( const auto successor : base.to_successors.at( lane_id ) )
+    {
+      const auto connection = base.find_connection( lane_id, successor );
+      if( connection->connection_type != adore::map::PARALLEL && reference.find_connection( lane_id, successor )->weight < closed )
+        reference.set_weight( lane_id, successor, 3.0 * connection->weight );
+    }
+  }
+  EXPECT_TRUE( overlay->close_connection( 1, 2 ) );
+  reference.set_weight( 1, 2, closed );
+  EXPECT_FALSE( overlay->close_connection( 1, 3 ) );
+  EXPECT_FALSE( overlay->close_lane( 100000 ) );
+  EXPECT_FALSE( overlay->lowers_weights() );
+
+  auto compare = [&]( const adore::map::WeightOverlay& weights, const adore::map::RoadGraph& expected_graph ) {
+    size_t found = 0;
+    for( int i = 0; i < 100; ++i )
+    {
+      const auto from = lane( rng );
+      const auto to   = lane( rng );
+      if( closed_lanes.count( from ) > 0 )
+        continue;
+      for( const bool allow_reverse : { false, true } )
+      {
+        const auto   actual   = grid.find_path( from, to, allow_reverse, weights );
+        const auto   expected = expected_graph.find_path( from, to, allow_reverse );
+        const double cost     = path_cost( expected_graph, expected, allow_reverse );
+        if( expected.empty() || cost >= closed )
+        {
+          EXPECT_TRUE( actual.empty() ) << from << " -> " << to;
+          continue;
+        }
+        ASSERT_FALSE( actual.empty() ) << from << " -> " << to;
+        EXPECT_NEAR( path_cost( expected_graph, actual, allow_reverse ), cost, 1e-6 );
+        ++found;
+
+        // The other searches see the same weights
+        const auto bidirectional = grid.find_path_bidirectional( from, to, allow_reverse, nullptr, &weights );
+        EXPECT_NEAR( path_cost( expected_graph, bidirectional, allow_reverse ), cost, 1e-6 );
+        const std::vector<adore::map::LaneID> targets{ to };
+        const auto reachable = grid.find_reachable( from, std::numeric_limits<double>::infinity(),
+                                                    allow_reverse ? adore::map::BOTH : adore::map::FORWARD, true, targets, &weights );
+        ASSERT_TRUE( reachable.find( to ) );
+        EXPECT_NEAR( reachable.find( to )->cost, cost, 1e-6 );
+        const auto backward = grid.find_reachable( to, std::numeric_limits<double>::infinity(), adore::map::BACKWARD, true,
+                                                   std::vector<adore::map::LaneID>{ from }, &weights );
+        if( !allow_reverse )
+        {
+          ASSERT_TRUE( backward.find( from ) );
+          EXPECT_NEAR( backward.find( from )->cost, cost, 1e-6 );
+        }
+        adore::map::AlternativeRouteConfig config;
+        config.allow_reverse = allow_reverse;
+        const auto routes    = grid.find_alternative_paths( from, to, config, &weights );
+        ASSERT_FALSE( routes.empty() );
+        EXPECT_NEAR( path_cost( expected_graph, routes.front(), allow_reverse ), cost, 1e-6 );
+      }
+    }
+    EXPECT_GT( found, 100u );
+  };
+
+  adore::map::WeightOverlayHandle handle;
+  EXPECT_FALSE( handle.get() );
+  EXPECT_THROW( handle.update( []( adore::map::WeightOverlay& ) {} ), std::logic_error );
+  EXPECT_EQ( handle.get_version(), 0u );
+  EXPECT_EQ( handle.publish( overlay ), 1u );
+  const auto published = handle.get();
+  compare( *published, reference );
+
+  // Cheaper lanes turn off the estimates of the graph, which no longer bound the remaining cost
+  auto cheaper = reference;
+  EXPECT_EQ( handle.update( [&]( adore::map::WeightOverlay& next ) {
+    for( adore::map::LaneID lane_id = 1; lane_id <= 20 * 25; lane_id += 7 )
+    {
+      next.scale_lane( lane_id, 0.1 );
+      for( const auto successor : base.to_successors.at( lane_id ) )
+      {
+        const auto connection = base.find_connection( lane_id, successor );
+        if( connection->connection_type != adore::map::PARALLEL && reference.find_connection( lane_id, successor )->weight < closed )
+          cheaper.set_weight( lane_id, successor, 0.1 * connection->weight );
+      }
+    }
+  } ),
+             2u );
+  EXPECT_TRUE( handle.get()->lowers_weights() );
+  EXPECT_FALSE( published->lowers_weights() );
+  compare( *handle.get(), cheaper );
+  compare( *published, reference );
+
+  // Lanes of a restricted type are never entered
+  for( auto& [lane_id, grid_lane] : lanes )
+    grid_lane->type = lane_id % 5 == 0 ? adore::map::bus : adore::map::driving;
+  adore::map::WeightOverlay cars( grid.compact );
+  cars.restrict_lane_types( lanes, { adore::map::bus, adore::map::tram } );
+  for( adore::map::LaneID to = 2; to <= 20 * 25; to += 37 )
+  {
+    const auto path = cars.find_path( 1, to, false );
+    if( to % 5 == 0 )
+    {
+      EXPECT_TRUE( path.empty() );
+    }
+    else
+    {
+      EXPECT_TRUE( std::none_of( path.begin(), path.end(), []( adore::map::LaneID lane_id ) { return lane_id % 5 == 0; } ) );
+    }
+  }
+
+  // Closed lanes are not entered backwards over their outgoing connections either, but can be left both ways
+  adore::map::WeightOverlay closure( grid.compact );
+  const adore::map::LaneID  closed_lane = 7 * 25 + 12;
+  closure.close_lane( closed_lane );
+  for( const auto successor : base.to_successors.at( closed_lane ) )
+  {
+    const auto path = grid.find_path( successor, closed_lane, true, closure );
+    EXPECT_TRUE( path.empty() ) << successor;
+    EXPECT_FALSE( grid.find_path( closed_lane, successor, true, closure ).empty() );
+    EXPECT_TRUE( grid.find_path_bidirectional( successor, closed_lane, true, nullptr, &closure ).empty() );
+  }
+  for( const auto predecessor : base.to_predecessors.at( closed_lane ) )
+    EXPECT_FALSE( grid.find_path( closed_lane, predecessor, true, closure ).empty() );
+  for( adore::map::LaneID from = 1; from <= 20 * 25; from += 13 )
+  {
+    for( adore::map::LaneID to = 2; to <= 20 * 25; to += 29 )
+    {
+      const auto path = grid.find_path( from, to, true, closure );
+      if( from != closed_lane && to != closed_lane )
+      {
+        EXPECT_EQ( std::count( path.begin(), path.end(), closed_lane ), 0 ) << from << " -> " << to;
+      }
+    }
+  }
+
+  // An overlay only routes on the graph it was made for, and only on the version of the lane graph it was
+  // made from. Copies of that version accept it, a changed graph or handle publishing it does not.
+  const auto other = adore::map::CompactRoadGraph::build( make_grid_graph( 5, 5, 1 ) );
+  EXPECT_THROW( other.find_path( 1, 25, false, nullptr, overlay.get() ), std::runtime_error );
+  auto copy = grid;
+  copy.build_compact();
+  EXPECT_FALSE( copy.find_path( 1, 20 * 25, false, *overlay ).empty() );
+  EXPECT_EQ( copy.find_path( 1, 20 * 25, false, handle ).size(), grid.find_path( 1, 20 * 25, false, *handle.get() ).size() );
+  copy.set_weight( 3, 4, 1.0 );
+  EXPECT_THROW( copy.find_path( 1, 20 * 25, false, *overlay ), std::runtime_error );
+  EXPECT_THROW( copy.find_path( 1, 20 * 25, false, handle ), std::runtime_error );
+  EXPECT_THROW( copy.find_reachable( 1, 100.0, adore::map::FORWARD, true, {}, overlay.get() ), std::runtime_error );
+  copy.build_compact();
+  EXPECT_THROW( copy.compact->find_path( 1, 20 * 25, false, nullptr, overlay.get() ), std::runtime_error );
+}
+
+// Without overlap and cost limits the alternatives are the k cheapest loopless paths, found by enumerating
+// all of them on a small grid. With limits every path respects them.
+TEST( RoadGraphTest, alternative_paths_are_k_shortest )
+{
+  auto grid = make_grid_graph( 3, 4, 8 );
+  EXPECT_THROW( grid.find_alternative_paths( 1, 12 ), std::runtime_error );
+  grid.build_compact();
+
+  std::vector<double>                       all_costs;
+  std::vector<adore::map::LaneID>           path{ 1 };
+  std::function<void( adore::map::LaneID )> enumerate = [&]( adore::map::LaneID lane_id ) {
+    if( lane_id == 12 )
+    {
+      all_costs.push_back( path_cost( grid, std::deque<adore::map::LaneID>( path.begin(), path.end() ), false ) );
+      return;
+    }
+    for( const auto next : grid.to_successors.at( lane_id ) )
+    {
+      if( std::find( path.begin(), path.end(), next ) != path.end() )
+        continue;
+      path.push_back( next );
+      enumerate( next );
+      path.pop_back();
+    }
+  };
+  enumerate( 1 );
+  std::sort( all_costs.begin(), all_costs.end() );
+  ASSERT_GT( all_costs.size(), 20u );
+
+  adore::map::AlternativeRouteConfig config;
+  config.route_count     = 20;
+  config.max_overlap     = 1.0;
+  config.max_cost_factor = std::numeric_limits<double>::infinity();
+  config.candidate_limit = 1000;
+  const auto paths       = grid.find_alternative_paths( 1, 12, config );
+  ASSERT_EQ( paths.size(), 20u );
+  for( size_t k = 0; k < paths.size(); ++k )
+  {
+    EXPECT_NEAR( path_cost( grid, paths[k], false ), all_costs[k], 1e-9 ) << k;
+    EXPECT_EQ( std::unordered_set<adore::map::LaneID>( paths[k].begin(), paths[k].end() ).size(), paths[k].size() );
+  }
+  EXPECT_EQ( std::set<std::deque<adore::map::LaneID>>( paths.begin(), paths.end() ).size(), paths.size() );
+
+  const auto& map   = load_test_map();
+  auto        big   = make_grid_graph( 30, 40, 4 );
+  auto        lanes = make_grid_lanes( 30, 40 );
+  big.build_compact( &lanes );
+  big.build_landmarks( adore::map::LandmarkConfig{ 4, 1 } );
+  for( const adore::map::RoadGraph* graph : std::vector<const adore::map::RoadGraph*>{ &map.lane_graph, &big } )
+  {
+    std::vector<adore::map::LaneID> lane_ids;
+    for( const auto& [lane_id, successors] : graph->to_successors )
+      lane_ids.push_back( lane_id );
+    std::sort( lane_ids.begin(), lane_ids.end() );
+
+    std::mt19937                          rng( 9 );
+    std::uniform_int_distribution<size_t> pick( 0, lane_ids.size() - 1 );
+    size_t                                alternatives = 0;
+    for( int i = 0; i < 20; ++i )
+    {
+      const auto from = lane_ids[pick( rng )];
+      const auto to   = lane_ids[pick( rng )];
+      for( const bool allow_reverse : { false, true } )
+      {
+        adore::map::AlternativeRouteConfig limited;
+        limited.route_count   = 4;
+        limited.allow_reverse = allow_reverse;
+
+        const auto shortest = graph->find_path( from, to, allow_reverse );
+        const auto routes   = graph->find_alternative_paths( from, to, limited );
+        ASSERT_EQ( shortest.empty(), routes.empty() );
+        if( routes.empty() )
+          continue;
+        EXPECT_LE( routes.size(), 4u );
+        alternatives += routes.size() - 1;
+
+        const double best = path_cost( *graph, shortest, allow_reverse );
+        EXPECT_NEAR( path_cost( *graph, routes[0], allow_reverse ), best, 1e-6 );
+        std::set<std::pair<adore::map::LaneID, adore::map::LaneID>> steps;
+        for( const auto& route : routes )
+        {
+          EXPECT_EQ( route.front(), from );
+          EXPECT_EQ( route.back(), to );
+          const double cost = path_cost( *graph, route, allow_reverse );
+          EXPECT_LE( cost, limited.max_cost_factor * best + 1e-6 );
+
+          double overlap = 0.0;
+          for( size_t j = 1; j < route.size(); ++j )
+          {
+            if( steps.count( { route[j - 1], route[j] } ) )
+              overlap += path_cost( *graph, { route[j - 1], route[j] }, allow_reverse );
+          }
+          if( &route != &routes.front() )
+          {
+            EXPECT_LE( overlap, limited.max_overlap * cost + 1e-6 );
+          }
+          for( size_t j = 1; j < route.size(); ++j )
+            steps.insert( { route[j - 1], route[j] } );
+        }
+      }
+    }
+    EXPECT_GT( alternatives, 10u );
+  }
+}
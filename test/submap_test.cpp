@@ -0,0 +1,248 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "adore_map/map.hpp"
+#include "adore_map/map_loader.hpp"
+#include "adore_map/map_view.hpp"
+#include "adore_map/submap_tracker.hpp"
+
+#ifndef ADORE_MAP_TEST_DATA_DIR
+  // Fallback – will be overridden from CMake for real tests.
+  #define ADORE_MAP_TEST_DATA_DIR "."
+#endif
+
+namespace
+{
+std::shared_ptr<const adore::map::Map>
+load_test_map()
+{
+  static const auto map = std::make_shared<const adore::map::Map>(
+    adore::map::MapLoader::load_from_file( std::string( ADORE_MAP_TEST_DATA_DIR ) + "/test_map.r2sr", true ) );
+  return map;
+}
+
+adore::map::MapPoint
+get_window_center( const adore::map::Map& map )
+{
+  const auto& points = map.lanes.begin()->second->borders.center.interpolated_points;
+  return points[points.size() / 2];
+}
+
+std::set<size_t>
+get_lane_ids( const adore::map::Map& map )
+{
+  std::set<size_t> ids;
+  for( const auto& [lane_id, lane] : map.lanes )
+    ids.insert( lane_id );
+  return ids;
+}
+} // namespace
+
+// A view selects the same lanes as the copying submap, but hands out the parent's lane objects.
+TEST( SubmapTest, view_matches_copied_submap_and_shares_lanes )
+{
+  const auto map    = load_test_map();
+  const auto center = get_window_center( *map );
+
+  adore::map::Map     copied = map->get_submap( center, 80.0, 80.0 );
+  adore::map::MapView view   = adore::map::MapView::create( map, center, 80.0, 80.0 );
+
+  ASSERT_FALSE( view.empty() );
+  const auto copied_ids = get_lane_ids( copied );
+  EXPECT_EQ( std::set<size_t>( view.get_lane_ids().begin(), view.get_lane_ids().end() ), copied_ids );
+
+  for( const auto& lane_id : view.get_lane_ids() )
+  {
+    EXPECT_EQ( view.get_lane( lane_id ).get(), map->lanes.at( lane_id ).get() ) << "View must not copy lane " << lane_id;
+  }
+
+  // Nearest point queries agree with the copied submap
+  double view_dist   = std::numeric_limits<double>::max();
+  double copied_dist = std::numeric_limits<double>::max();
+  auto   view_near   = view.get_nearest_point( center, view_dist );
+  auto   copied_near = copied.quadtree.get_nearest_point( center, copied_dist );
+  ASSERT_TRUE( view_near.has_value() );
+  ASSERT_TRUE( copied_near.has_value() );
+  EXPECT_DOUBLE_EQ( view_dist, copied_dist );
+}
+
+// Materializing a view yields the same lanes, roads and connections as the copying submap.
+TEST( SubmapTest, view_to_map_matches_copied_submap )
+{
+  const auto map    = load_test_map();
+  const auto center = get_window_center( *map );
+
+  adore::map::Map copied       = map->get_submap( center, 80.0, 80.0 );
+  adore::map::Map materialized = adore::map::MapView::create( map, center, 80.0, 80.0 ).to_map();
+
+  EXPECT_EQ( get_lane_ids( materialized ), get_lane_ids( copied ) );
+  EXPECT_EQ( materialized.roads.size(), copied.roads.size() );
+  EXPECT_EQ( materialized.lane_graph.all_connections.size(), copied.lane_graph.all_connections.size() );
+
+  for( const auto& [lane_id, lane] : materialized.lanes )
+  {
+    EXPECT_EQ( lane.get(), map->lanes.at( lane_id ).get() );
+  }
+
+  // Every connection of the parent between two submap lanes is kept
+  for( const auto& connection : map->lane_graph.all_connections )
+  {
+    if( materialized.lanes.count( connection.from_id ) && materialized.lanes.count( connection.to_id ) )
+    {
+      EXPECT_TRUE( materialized.lane_graph.find_connection( connection.from_id, connection.to_id ).has_value() );
+    }
+  }
+}
+
+// Paths found through a view never leave the view.
+TEST( SubmapTest, view_paths_stay_inside_view )
+{
+  const auto map    = load_test_map();
+  const auto center = get_window_center( *map );
+
+  adore::map::MapView view = adore::map::MapView::create( map, center, 120.0, 120.0 );
+  ASSERT_GE( view.size(), 2u );
+
+  for( const auto& from : view.get_lane_ids() )
+  {
+    for( const auto& to : view.get_successors( from ) )
+    {
+      auto path = view.find_path( from, to );
+      ASSERT_FALSE( path.empty() );
+      for( const auto& lane_id : path )
+        EXPECT_TRUE( view.contains_lane( lane_id ) );
+    }
+  }
+}
+
+// Moving the tracker window step by step keeps its submap identical to a freshly extracted submap.
+TEST( SubmapTest, tracker_matches_fresh_submap_while_moving )
+{
+  const auto map = load_test_map();
+
+  // Walk along the center lines of consecutive lanes
+  std::vector<adore::map::MapPoint> centers;
+  for( const auto& [lane_id, lane] : map->lanes )
+  {
+    const auto& points = lane->borders.center.interpolated_points;
+    for( size_t i = 0; i < points.size(); i += 10 )
+      centers.push_back( points[i] );
+    if( centers.size() > 100 )
+      break;
+  }
+
+  adore::map::SubmapTracker tracker( map, 60.0, 60.0 );
+  std::set<size_t>          tracked_ids;
+  size_t                    removed_count = 0;
+
+  for( const auto& center : centers )
+  {
+    auto delta     = tracker.update( center );
+    removed_count += delta.removed_lane_ids.size();
+
+    for( const auto& lane_id : delta.removed_lane_ids )
+      EXPECT_EQ( tracked_ids.erase( lane_id ), 1u ) << "Removed lane " << lane_id << " was not tracked";
+    for( const auto& lane_id : delta.added_lane_ids )
+      EXPECT_TRUE( tracked_ids.insert( lane_id ).second ) << "Added lane " << lane_id << " was already tracked";
+
+    const adore::map::Map  fresh   = map->get_submap( center, 60.0, 60.0 );
+    const adore::map::Map& tracked = tracker.get_submap();
+
+    ASSERT_EQ( get_lane_ids( tracked ), get_lane_ids( fresh ) );
+    EXPECT_EQ( get_lane_ids( tracked ), tracked_ids );
+    EXPECT_EQ( tracked.roads.size(), fresh.roads.size() );
+    EXPECT_EQ( tracked.lane_graph.all_connections.size(), fresh.lane_graph.all_connections.size() );
+
+    double tracked_dist = std::numeric_limits<double>::max();
+    double fresh_dist   = std::numeric_limits<double>::max();
+    tracked.quadtree.get_nearest_point( center, tracked_dist );
+    fresh.quadtree.get_nearest_point( center, fresh_dist );
+    EXPECT_DOUBLE_EQ( tracked_dist, fresh_dist );
+  }
+  EXPECT_GT( removed_count, 0u ) << "Window never moved far enough to drop a lane";
+}
+
+// Window queries answered from tiles select exactly the lanes the global quadtree selects.
+TEST( SubmapTest, tiled_window_queries_match_quadtree )
+{
+  const auto      map = load_test_map();
+  adore::map::Map tiled( *map );
+  tiled.build_tiles( 50.0, 4 );
+  ASSERT_TRUE( tiled.tiles );
+  EXPECT_GT( tiled.tiles->size(), 1u );
+
+  for( const auto& [lane_id, lane] : map->lanes )
+  {
+    const auto& center = lane->borders.center.interpolated_points.front();
+    for( double size : { 20.0, 75.0, 230.0 } )
+    {
+      adore::map::TileGrid::Boundary window{ center.x - size / 2, center.x + size / 2, center.y - size / 2, center.y + size / 2 };
+      EXPECT_EQ( tiled.get_lane_ids_in( window ), map->get_lane_ids_in( window ) );
+    }
+  }
+
+  // Submaps extracted through the tiles are the same as without tiles
+  const auto center = get_window_center( *map );
+  EXPECT_EQ( get_lane_ids( tiled.get_submap( center, 80.0, 80.0 ) ), get_lane_ids( map->get_submap( center, 80.0, 80.0 ) ) );
+}
+
+// Tiles follow lanes removed from, inserted into and replaced in a tiled map, earlier copies keep their grid.
+TEST( SubmapTest, tiles_follow_inserted_and_removed_lanes )
+{
+  const auto      map = load_test_map();
+  adore::map::Map tiled( *map );
+  tiled.build_tiles( 50.0, 4 );
+  const auto original_tiles = tiled.tiles;
+
+  const auto  lane   = map->lanes.begin()->second;
+  const auto& center = lane->borders.center.interpolated_points.front();
+  adore::map::TileGrid::Boundary window{ center.x - 40.0, center.x + 40.0, center.y - 40.0, center.y + 40.0 };
+
+  auto contains = []( const std::vector<adore::map::LaneID>& ids, adore::map::LaneID id ) {
+    return std::binary_search( ids.begin(), ids.end(), id );
+  };
+
+  ASSERT_TRUE( tiled.remove_lane( lane->id ) );
+  EXPECT_FALSE( contains( tiled.get_lane_ids_in( window ), lane->id ) );
+  EXPECT_TRUE( contains( original_tiles->get_lane_ids( window ), lane->id ) );
+
+  tiled.insert_lane( lane );
+  EXPECT_EQ( tiled.get_lane_ids_in( window ), map->get_lane_ids_in( window ) );
+
+  // A lane moved to new cells leaves the old ones
+  auto moved = std::make_shared<adore::map::Lane>( *lane );
+  for( auto& point : moved->borders.center.interpolated_points )
+    point.x += 1000.0;
+  tiled.remove_lane( lane->id );
+  tiled.insert_lane( moved );
+  EXPECT_FALSE( contains( tiled.tiles->get_lane_ids( window ), lane->id ) );
+  adore::map::TileGrid::Boundary moved_window{ window.x_min + 1000.0, window.x_max + 1000.0, window.y_min, window.y_max };
+  EXPECT_TRUE( contains( tiled.tiles->get_lane_ids( moved_window ), lane->id ) );
+
+  // Inserting under a stored id replaces the lane in the store, the tiles and the quadtree
+  tiled.insert_lane( lane );
+  EXPECT_EQ( tiled.lanes.at( lane->id ), lane );
+  EXPECT_EQ( tiled.get_lane_ids_in( window ), map->get_lane_ids_in( window ) );
+  EXPECT_FALSE( contains( tiled.get_lane_ids_in( moved_window ), lane->id ) );
+  tiled.tiles.reset();
+  EXPECT_EQ( tiled.get_lane_ids_in( window ), map->get_lane_ids_in( window ) );
+  EXPECT_FALSE( contains( tiled.get_lane_ids_in( moved_window ), lane->id ) );
+}
@@ -0,0 +1,71 @@
+/********************************************************************************
+ * Copyright (c) 2025 Contributors to the Eclipse Foundation
+ *
+ * See the NOTICE file(s) distributed with this work for additional
+ * information regarding copyright ownership.
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Eclipse Public License 2.0 which is available at
+ * https://www.eclipse.org/legal/epl-2.0
+ *
+ * SPDX-License-Identifier: EPL-2.0
+ ********************************************************************************/
+
+// Offline compiler from R2S / OpenDRIVE maps to the memory mappable compiled map format.
+//
+// usage: adore_map_compile <input .r2sr|.xodr> <output .admap> [--no-lane-changes] [--ignore-non-driving]
+
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+
+#include "adore_map/compiled_map.hpp"
+#include "adore_map/map_loader.hpp"
+
+int
+main( int argc, char** argv )
+{
+  if( argc < 3 )
+  {
+    std::cerr << "usage: " << argv[0] << " <input .r2sr|.xodr> <output .admap> [--no-lane-changes] [--ignore-non-driving]" << std::endl;
+    return 2;
+  }
+
+  const std::string input  = argv[1];
+  const std::string output = argv[2];
+
+  bool allow_lane_changes = true;
+  bool ignore_non_driving = false;
+  for( int i = 3; i < argc; ++i )
+  {
+    const std::string option = argv[i];
+    if( option == "--no-lane-changes" )
+      allow_lane_changes = false;
+    else if( option == "--ignore-non-driving" )
+      ignore_non_driving = true;
+    else
+    {
+      std::cerr << "unknown option: " << option << std::endl;
+      return 2;
+    }
+  }
+
+  try
+  {
+    const auto start = std::chrono::steady_clock::now();
+
+    auto map = adore::map::MapLoader::load_from_file( input, allow_lane_changes, ignore_non_driving );
+    adore::map::write_compiled_map( map, output );
+
+    const auto elapsed = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+    std::cout << "compiled " << map.lanes.size() << " lanes, " << map.roads.size() << " roads and "
+              << map.lane_graph.all_connections.size() << " connections into " << output << " in " << elapsed << " s" << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    std::cerr << "adore_map_compile: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}